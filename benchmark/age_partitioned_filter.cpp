@@ -0,0 +1,135 @@
+/* Measures insertion, lookup and generation shift times of
+ * boost::bloom::age_partitioned_filter for a stream of distinct elements
+ * spanning several generations, along with the empirical FPR.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data,
+                                  fresh;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t/num_elements*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+/* the stream spans 8 generations */
+
+template<typename Filter>
+void test(const std::string& name)
+{
+  std::size_t g=num_elements/8,
+              m=Filter::capacity_for(g);
+  print(name,"insertion",measure([&]{
+    Filter f(m,g);
+    for(auto x:data)f.insert(x);
+    return f.capacity();
+  }));
+  print(name,"bulk insertion",measure([&]{
+    Filter f(m,g);
+    f.insert(data.begin(),data.end());
+    return f.capacity();
+  }));
+  Filter f(m,g);
+  f.insert(data.begin(),data.end());
+  print(name,"lookup",measure([&]{
+    std::size_t res=0;
+    for(auto x:fresh)res+=f.may_contain(x);
+    return res;
+  }));
+  print(name,"bulk lookup",measure([&]{
+    std::size_t res=0;
+    f.may_contain(
+      fresh.begin(),fresh.end(),[&](std::uint64_t,bool b){res+=b;});
+    return res;
+  }));
+  print(name,"shift (per element of a generation)",measure([&]{
+    f.shift();
+    return f.capacity();
+  })*num_elements/g);
+  f=Filter(m,g);
+  f.insert(data.begin(),data.end());
+  std::size_t fp=0;
+  for(auto x:fresh)fp+=f.may_contain(x);
+  std::cout<<std::setw(10)<<(double)fp/fresh.size()*100<<
+    "% FPR (at most "<<Filter::fpr_for(g,f.capacity())*100<<"%), "<<
+    name<<"\n";
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)fresh.push_back(rng());
+
+  std::cout<<"n="<<num_elements<<", times in ns per element\n";
+  test<age_partitioned_filter<std::uint64_t,4,3>>(
+    "age_partitioned_filter<uint64_t,4,3>");
+  test<age_partitioned_filter<std::uint64_t,10,7>>(
+    "age_partitioned_filter<uint64_t,10,7>");
+  test<age_partitioned_filter<std::uint64_t,14,11>>(
+    "age_partitioned_filter<uint64_t,14,11>");
+}
@@ -319,6 +319,13 @@ using filters4=boost::mp11::mp_list<
   filter<int,1,multiblock<std::uint64_t[8],K3>>
 >;
 
+template<std::size_t K1,std::size_t K2,std::size_t K3>
+using filters5=boost::mp11::mp_list<
+  filter<int,1,sectorized_block<std::uint64_t,4,K1>>,
+  filter<int,1,sectorized_block<std::uint64_t,4,K2>,1>,
+  filter<int,1,sectorized_block<std::uint64_t,8,K3>,1>
+>;
+
 int main(int argc,char* argv[])
 {
   if(argc<2){
@@ -419,5 +426,24 @@ int main(int argc,char* argv[])
   row<filters4< 9, 10, 11>>(16);
   row<filters4<12, 12, 15>>(20);
 
+  std::cout<<
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"5\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,4,K>></code></th>\n"
+    "    <th colspan=\"5\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,4,K>,1></code></th>\n"
+    "    <th colspan=\"5\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,8,K>,1></code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    subheader<<
+    subheader<<
+    "  </tr>\n";
+
+  row<filters5< 4,  4,  8>>( 8);
+  row<filters5< 8,  8,  8>>(12);
+  row<filters5< 8,  8,  8>>(16);
+  row<filters5<10, 12, 16>>(20);
+
   std::cout<<"</table>\n";
 }
@@ -80,6 +80,36 @@ struct unordered_flat_set_filter
 
 static std::size_t num_elements;
 
+template<typename T>
+void make_data(
+  std::vector<T>& data_in,std::vector<T>& data_out,std::vector<T>& data_mixed,
+  std::uint64_t mixed_lookup_cut)
+{
+  boost::detail::splitmix64    rng;
+  boost::unordered_flat_set<T> unique;
+  for(std::size_t i=0;i<num_elements;++i){
+    for(;;){
+      auto x=T(rng());
+      if(unique.insert(x).second){
+        data_in.push_back(x);
+        break;
+      }
+    }
+  }
+  for(std::size_t i=0;i<num_elements;++i){
+    for(;;){
+      auto x=T(rng());
+      if(!unique.contains(x)){
+        data_out.push_back(x);
+        break;
+      }
+    }
+  }
+  for(std::size_t i=0;i<num_elements;++i){
+    data_mixed.push_back(rng()<mixed_lookup_cut?data_in[i]:data_out[i]);
+  }
+}
+
 struct test_results
 {
   double fpr;                      /* % */
@@ -100,31 +130,7 @@ test_results test(std::size_t c)
       lookup_mix*(double)(std::numeric_limits<std::uint64_t>::max)());
 
   std::vector<value_type> data_in,data_out,data_mixed;
-  {
-    boost::detail::splitmix64             rng;
-    boost::unordered_flat_set<value_type> unique;
-    for(std::size_t i=0;i<num_elements;++i){
-      for(;;){
-        auto x=value_type(rng());
-        if(unique.insert(x).second){
-          data_in.push_back(x);
-          break;
-        }
-      }
-    }
-    for(std::size_t i=0;i<num_elements;++i){
-      for(;;){
-        auto x=value_type(rng());
-        if(!unique.contains(x)){
-          data_out.push_back(x);
-          break;
-        }
-      }
-    }
-    for(std::size_t i=0;i<num_elements;++i){
-      data_mixed.push_back(rng()<mixed_lookup_cut?data_in[i]:data_out[i]);
-    }
-  }
+  make_data(data_in,data_out,data_mixed,mixed_lookup_cut);
 
   double fpr=0.0;
   {
@@ -182,6 +188,52 @@ test_results test(std::size_t c)
     successful_lookup_time,unsuccessful_lookup_time,mixed_lookup_time};
 }
 
+/* mixed lookup times for decreasing proportions of successful lookups,
+ * used to compare plain and cascaded filters.
+ */
+
+static constexpr double negative_ratios[]={0.5,0.9,0.99};
+static constexpr std::size_t num_negative_ratios=
+  sizeof(negative_ratios)/sizeof(negative_ratios[0]);
+
+struct cascaded_test_results
+{
+  double fpr;                                     /* % */
+  double insertion_time;                          /* ns per element */
+  double mixed_lookup_time[num_negative_ratios];  /* ns per element */
+};
+
+template<typename Filter>
+cascaded_test_results cascaded_test(std::size_t c)
+{
+  using value_type=typename Filter::value_type;
+
+  cascaded_test_results res;
+  {
+    auto r=test<Filter>(c);
+    res.fpr=r.fpr;
+    res.insertion_time=r.insertion_time;
+  }
+  for(std::size_t i=0;i<num_negative_ratios;++i){
+    std::uint64_t mixed_lookup_cut=
+      (std::uint64_t)(
+        (1.0-negative_ratios[i])*
+        (double)(std::numeric_limits<std::uint64_t>::max)());
+    std::vector<value_type> data_in,data_out,data_mixed;
+    make_data(data_in,data_out,data_mixed,mixed_lookup_cut);
+
+    Filter f(c*num_elements);
+    for(const auto& x:data_in)f.insert(x);
+    double t=measure([&]{
+      std::size_t res=0;
+      for(const auto& x:data_mixed)res+=f.may_contain(x);
+      return res;
+    });
+    res.mixed_lookup_time[i]=t/num_elements*1E9;
+  }
+  return res;
+}
+
 struct print_double
 {
   print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
@@ -223,6 +275,36 @@ template<typename Filters> void row(std::size_t c)
     "  </tr>\n";
 }
 
+template<typename Filters> void cascaded_row(std::size_t c)
+{
+  std::cout<<
+    "  <tr>\n"
+    "    <td align=\"center\">"<<c<<"</td>\n";
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,Filters>
+  >([&](auto i){
+    using filter=typename decltype(i)::type;
+    auto res=cascaded_test<filter>(c);
+    std::cout<<
+      "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n";
+    for(auto t:res.mixed_lookup_time){
+      std::cout<<"    <td align=\"right\">"<<print_double(t)<<"</td>\n";
+    }
+  });
+
+  /* bits per element of the default front array of the last filter */
+
+  using cascaded=boost::mp11::mp_back<Filters>;
+  std::cout<<
+    "    <td align=\"right\">"<<
+      print_double(
+        (double)cascaded(c*num_elements).front_capacity()/num_elements)<<
+      "</td>\n"
+    "  </tr>\n";
+}
+
 using namespace boost::bloom;
 
 template<std::size_t K1,std::size_t K2,std::size_t K3>
@@ -253,6 +335,19 @@ using filters4=boost::mp11::mp_list<
   filter<int,1,multiblock<std::uint64_t[8],K3>>
 >;
 
+template<std::size_t K1,std::size_t K2,std::size_t K3>
+using filters5=boost::mp11::mp_list<
+  filter<int,1,sectorized_block<std::uint64_t,4,K1>>,
+  filter<int,1,sectorized_block<std::uint64_t,4,K2>,1>,
+  filter<int,1,sectorized_block<std::uint64_t,8,K3>,1>
+>;
+
+template<std::size_t K>
+using cascaded_filters=boost::mp11::mp_list<
+  filter<int,1,fast_multiblock64<K>>,
+  cascaded_filter<int,1,fast_multiblock64<K>>
+>;
+
 int main(int argc,char* argv[])
 {
   if(argc<2){
@@ -374,5 +469,57 @@ int main(int argc,char* argv[])
   row<filters4< 9, 10, 11>>(16);
   row<filters4<12, 12, 15>>(20);
 
+  std::cout<<
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"6\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,4,K>></code></th>\n"
+    "    <th colspan=\"6\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,4,K>,1></code></th>\n"
+    "    <th colspan=\"6\"><code>filter&lt;int,1,sectorized_block&lt;uint64_t,8,K>,1></code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>c</th>\n"<<
+    subheader<<
+    subheader<<
+    subheader<<
+    "  </tr>\n";
+
+  row<filters5< 4,  4,  8>>( 8);
+  row<filters5< 8,  8,  8>>(12);
+  row<filters5< 8,  8,  8>>(16);
+  row<filters5<10, 12, 16>>(20);
+
+  std::cout<<"</table>\n";
+
+  /* cascaded filter table: mixed lookup times for several proportions of
+   * unsuccessful lookups.
+   */
+
+  std::cout<<
+    "<table class=\"bordered_table\" style=\"font-size: 85%;\">\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\""<<num_negative_ratios+2<<"\"><code>filter&lt;int,1,fast_multiblock64&lt;K>></code></th>\n"
+    "    <th colspan=\""<<num_negative_ratios+3<<"\"><code>cascaded_filter&lt;int,1,fast_multiblock64&lt;K>></code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>c</th>\n";
+  for(int i=0;i<2;++i){
+    std::cout<<
+      "    <th>FPR<br/>[%]</th>\n"
+      "    <th>ins.</th>\n";
+    for(auto r:negative_ratios){
+      std::cout<<
+        "    <th>"<<r*100<<"% uns.<br/>lkp.</th>\n";
+    }
+  }
+  std::cout<<
+    "    <th>front<br/>c</th>\n"
+    "  </tr>\n";
+
+  cascaded_row<cascaded_filters< 5>>( 8);
+  cascaded_row<cascaded_filters< 8>>(12);
+  cascaded_row<cascaded_filters<11>>(16);
+  cascaded_row<cascaded_filters<13>>(20);
+
   std::cout<<"</table>\n";
 }
@@ -0,0 +1,130 @@
+/* Measures insertion, estimation and halving times of
+ * boost::bloom::count_min_sketch for a stream of elements with skewed
+ * frequencies.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t/num_elements*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+template<typename Sketch>
+void test(const std::string& name)
+{
+  /* one counter per element of the stream */
+
+  std::size_t m=num_elements*sizeof(typename Sketch::counter_type)*8;
+  print(name,"insertion",measure([&]{
+    Sketch s(m);
+    for(auto x:data)s.insert(x);
+    return s.capacity();
+  }));
+  print(name,"bulk insertion",measure([&]{
+    Sketch s(m);
+    s.insert(data.begin(),data.end());
+    return s.capacity();
+  }));
+  Sketch s(data.begin(),data.end(),m);
+  print(name,"estimation",measure([&]{
+    std::size_t res=0;
+    for(auto x:data)res+=s.estimate(x);
+    return res;
+  }));
+  print(name,"bulk estimation",measure([&]{
+    std::size_t res=0;
+    s.estimate(
+      data.begin(),data.end(),[&](std::uint64_t,std::size_t c){res+=c;});
+    return res;
+  }));
+  print(name,"halving",measure([&]{
+    s.halve();
+    return s.capacity();
+  }));
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  /* element i has probability ~1/i (Zipf with exponent 1) */
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i){
+    double u=(double)(rng()>>11)/(double)(std::uint64_t(1)<<53);
+    data.push_back((std::uint64_t)std::pow((double)num_elements,u));
+  }
+
+  std::cout<<"n="<<num_elements<<", times in ns per element\n";
+  test<count_min_sketch<std::uint64_t,4,std::uint8_t>>(
+    "count_min_sketch<uint64_t,4,uint8_t>");
+  test<count_min_sketch<std::uint64_t,4,std::uint32_t>>(
+    "count_min_sketch<uint64_t,4,uint32_t>");
+  test<count_min_sketch<std::uint64_t,8,std::uint16_t>>(
+    "count_min_sketch<uint64_t,8,uint16_t>");
+}
@@ -0,0 +1,255 @@
+/* Insertion and lookup with block<std::uint64_t[8],K> vs. subfilters with
+ * the same bit layout whose fingerprints are built in SIMD registers and
+ * checked with a single vector test.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/block_base.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/* Bit n of a block<std::uint64_t[8],K> value is stored in bit n/8 of word
+ * n%8. avx512_block and avx2_block keep this layout, so their filters end up
+ * with the same contents as those of block<std::uint64_t[8],K>.
+ */
+
+#if defined(BOOST_BLOOM_AVX512)
+template<std::size_t K>
+struct avx512_block:boost::bloom::block<std::uint64_t[8],K>
+{
+  using value_type=std::uint64_t[8];
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    _mm512_storeu_si512(
+      x,_mm512_or_si512(_mm512_loadu_si512(x),fingerprint(hash)));
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    __m512i fp=fingerprint(hash);
+    return _mm512_test_epi64_mask(
+      boost::bloom::detail::mm512_andnot_si512(_mm512_loadu_si512(x),fp),
+      fp)==0;
+  }
+
+private:
+  using base=boost::bloom::detail::block_base<std::uint64_t[8],K>;
+
+  static BOOST_FORCEINLINE __m512i fingerprint(std::uint64_t hash)
+  {
+    __m512i fp=_mm512_setzero_si512();
+    base::loop(hash,[&](std::uint64_t h){
+      fp=_mm512_or_si512(
+        fp,
+        _mm512_maskz_set1_epi64(
+          (__mmask8)(1u<<(h&7)),(long long)(1ull<<((h>>3)&63))));
+    });
+    return fp;
+  }
+};
+#endif
+
+#if defined(BOOST_BLOOM_AVX2)
+template<std::size_t K>
+struct avx2_block:boost::bloom::block<std::uint64_t[8],K>
+{
+  using value_type=std::uint64_t[8];
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    __m256i lo,hi;
+    fingerprint(hash,lo,hi);
+    __m256i* p=reinterpret_cast<__m256i*>(x);
+    _mm256_storeu_si256(p,_mm256_or_si256(_mm256_loadu_si256(p),lo));
+    _mm256_storeu_si256(p+1,_mm256_or_si256(_mm256_loadu_si256(p+1),hi));
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    __m256i lo,hi;
+    fingerprint(hash,lo,hi);
+    const __m256i* p=reinterpret_cast<const __m256i*>(x);
+    return
+      _mm256_testc_si256(_mm256_loadu_si256(p),lo)&
+      _mm256_testc_si256(_mm256_loadu_si256(p+1),hi);
+  }
+
+private:
+  using base=boost::bloom::detail::block_base<std::uint64_t[8],K>;
+
+  static BOOST_FORCEINLINE void fingerprint(
+    std::uint64_t hash,__m256i& lo,__m256i& hi)
+  {
+    const __m256i lanes_lo=_mm256_set_epi32(3,3,2,2,1,1,0,0),
+                  lanes_hi=_mm256_set_epi32(7,7,6,6,5,5,4,4);
+
+    lo=hi=_mm256_setzero_si256();
+    base::loop(hash,[&](std::uint64_t h){
+      __m256i bit=_mm256_set1_epi64x((long long)(1ull<<((h>>3)&63))),
+              lane=_mm256_set1_epi32((int)(h&7));
+      lo=_mm256_or_si256(
+        lo,_mm256_and_si256(bit,_mm256_cmpeq_epi32(lanes_lo,lane)));
+      hi=_mm256_or_si256(
+        hi,_mm256_and_si256(bit,_mm256_cmpeq_epi32(lanes_hi,lane)));
+    });
+  }
+};
+#endif
+
+static std::size_t num_elements;
+
+struct test_results
+{
+  double insertion_time; /* ns per element */
+  double lookup_time;    /* ns per element */
+};
+
+template<typename Filter>
+test_results test(std::size_t c)
+{
+  std::vector<int> data_in,data_mixed;
+  {
+    boost::detail::splitmix64 rng;
+    for(std::size_t i=0;i<num_elements;++i)data_in.push_back((int)rng());
+    for(std::size_t i=0;i<num_elements;++i){
+      data_mixed.push_back(i%2?data_in[i]:(int)rng());
+    }
+  }
+
+  Filter       f(c*num_elements);
+  test_results res;
+  res.insertion_time=measure([&]{
+    f.clear();
+    f.insert(data_in.begin(),data_in.end());
+    return 0;
+  })/num_elements*1E9;
+  res.lookup_time=measure([&]{
+    std::size_t res=0;
+    f.may_contain(
+      data_mixed.begin(),data_mixed.end(),[&](int,bool b){res+=b;});
+    return res;
+  })/num_elements*1E9;
+
+  boost::bloom::filter<int,1,boost::bloom::block<std::uint64_t[8],Filter::subfilter::k>>
+    f2(c*num_elements);
+  f2.insert(data_in.begin(),data_in.end());
+  if(!std::equal(f.array().begin(),f.array().end(),f2.array().begin())){
+    std::cerr<<"SIMD subfilter produced different results\n";
+    std::exit(EXIT_FAILURE);
+  }
+  return res;
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+template<std::size_t K>
+void row(std::size_t c)
+{
+  using namespace boost::bloom;
+
+  auto res=test<filter<int,1,block<std::uint64_t[8],K>>>(c);
+  std::cout<<
+    "K="<<K<<"\n"
+    "  scalar:  "<<print_double(res.insertion_time)<<" / "<<
+    print_double(res.lookup_time)<<"\n";
+#if defined(BOOST_BLOOM_AVX512)
+  res=test<filter<int,1,avx512_block<K>>>(c);
+  std::cout<<
+    "  AVX-512: "<<print_double(res.insertion_time)<<" / "<<
+    print_double(res.lookup_time)<<"\n";
+#endif
+#if defined(BOOST_BLOOM_AVX2)
+  res=test<filter<int,1,avx2_block<K>>>(c);
+  std::cout<<
+    "  AVX2:    "<<print_double(res.insertion_time)<<" / "<<
+    print_double(res.lookup_time)<<"\n";
+#endif
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  std::size_t c=12;
+  std::cout<<
+    "c="<<c<<", block<uint64_t[8],K>, "
+    "times in ns per element (insertion / mixed lookup)\n";
+  row<4>(c);
+  row<6>(c);
+  row<8>(c);
+  row<12>(c);
+}
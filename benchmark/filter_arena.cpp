@@ -0,0 +1,157 @@
+/* Compares many small filters held in a boost::bloom::filter_arena with
+ * the same number of individually allocated boost::bloom::filters: memory
+ * per filter (excluding the allocator's own bookkeeping for the latter),
+ * construction and insertion time, lookup time on random filters, and
+ * time to clear all filters.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_filters;
+static const std::size_t          n=10; /* elements per filter */
+static std::vector<std::uint64_t> data;
+static std::vector<std::size_t>   targets; /* filters to look up */
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t<<"  "<<op<<", "<<name<<"\n";
+}
+
+template<typename Subfilter>
+void test(const std::string& name)
+{
+  using filter=boost::bloom::filter<std::uint64_t,1,Subfilter>;
+  using arena=boost::bloom::filter_arena<std::uint64_t,1,Subfilter>;
+  using handle=typename arena::handle;
+
+  std::size_t m=filter::capacity_for(n,0.01);
+  auto        first=[&](std::size_t j){return data.begin()+j*n;};
+
+  {
+    arena a(m);
+    print(name,"bytes per filter, arena (slot + handle)",
+      (double)(a.slot_size()+sizeof(handle)));
+    print(name,"bytes per filter, filter (object + array)",
+      (double)(sizeof(filter)+
+        (filter(m).capacity()/8+BOOST_BLOOM_CACHELINE_SIZE-1)));
+  }
+
+  print(name,"ns per filter, arena construction",measure([&]{
+    arena               a(m);
+    std::vector<handle> hs;
+    hs.reserve(num_filters);
+    for(std::size_t j=0;j<num_filters;++j){
+      hs.push_back(a.add(first(j),first(j+1)));
+    }
+    return a.size();
+  })/num_filters*1E9);
+  print(name,"ns per filter, filter construction",measure([&]{
+    std::vector<filter> fs;
+    fs.reserve(num_filters);
+    for(std::size_t j=0;j<num_filters;++j){
+      fs.emplace_back(first(j),first(j+1),m);
+    }
+    return fs.size();
+  })/num_filters*1E9);
+
+  arena               a(m);
+  std::vector<handle> hs;
+  std::vector<filter> fs;
+  for(std::size_t j=0;j<num_filters;++j){
+    hs.push_back(a.add(first(j),first(j+1)));
+    fs.emplace_back(first(j),first(j+1),m);
+  }
+  print(name,"ns per lookup, arena",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<targets.size();++i){
+      res+=hs[targets[i]].may_contain(data[i]);
+    }
+    return res;
+  })/targets.size()*1E9);
+  print(name,"ns per lookup, filter",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<targets.size();++i){
+      res+=fs[targets[i]].may_contain(data[i]);
+    }
+    return res;
+  })/targets.size()*1E9);
+  print(name,"ns per filter, arena clear",measure([&]{
+    a.clear();
+    return a.size();
+  })/num_filters*1E9);
+  print(name,"ns per filter, filter clear",measure([&]{
+    for(auto& f:fs)f.clear();
+    return fs.size();
+  })/num_filters*1E9);
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of filters\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_filters=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_filters*n;++i)data.push_back(rng());
+  for(std::size_t i=0;i<1000000;++i)targets.push_back(rng()%num_filters);
+
+  std::cout<<"filters="<<num_filters<<", "<<n<<" elements per filter\n";
+  test<boost::bloom::block<unsigned char,7>>("block<unsigned char,7>");
+  test<boost::bloom::block<std::uint64_t,7>>("block<uint64_t,7>");
+}
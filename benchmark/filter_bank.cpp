@@ -0,0 +1,165 @@
+/* Compares the time to find the members of a set of Bloom filters that may
+ * contain a given element with boost::bloom::filter_bank against querying
+ * independent boost::bloom::filters one by one. Also measures insertion
+ * and batch vs. one-by-one removal of members.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_members;
+static const std::size_t          n=100; /* elements per member */
+static const double               fpr=0.01;
+static const std::size_t          num_lookups=1000;
+static std::vector<std::uint64_t> data,
+                                  fresh;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(12)<<t*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+template<std::size_t K>
+void test()
+{
+  using bank_type=boost::bloom::filter_bank<std::uint64_t,K>;
+  using filter_type=boost::bloom::filter<std::uint64_t,K>;
+
+  std::string name="K="+std::to_string(K);
+  std::size_t m=bank_type::capacity_for(n,fpr);
+  auto        first=[&](std::size_t j){return data.begin()+j*n;};
+
+  print(name,"filter_bank insertion (per element)",measure([&]{
+    bank_type b(m);
+    for(std::size_t j=0;j<num_members;++j)b.add(first(j),first(j+1));
+    return b.size();
+  })/data.size());
+
+  bank_type                b(m);
+  std::vector<filter_type> fs;
+  for(std::size_t j=0;j<num_members;++j){
+    b.add(first(j),first(j+1));
+    fs.emplace_back(first(j),first(j+1),m);
+  }
+
+  print(name,"filter_bank match (per lookup)",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<num_lookups;++i){
+      b.match(fresh[i],[&](std::size_t j){res+=j;});
+    }
+    return res;
+  })/num_lookups);
+  print(name,"filter_bank match hit (per lookup)",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<num_lookups;++i){
+      b.match(data[i*(data.size()/num_lookups)],[&](std::size_t j){res+=j;});
+    }
+    return res;
+  })/num_lookups);
+  print(name,"filter one by one (per lookup)",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<num_lookups;++i){
+      for(std::size_t j=0;j<num_members;++j){
+        if(fs[j].may_contain(fresh[i]))res+=j;
+      }
+    }
+    return res;
+  })/num_lookups);
+  print(name,"filter_bank match_all of 2 (per lookup)",measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<num_lookups;++i){
+      b.match_all(
+        fresh.begin()+i,fresh.begin()+i+2,[&](std::size_t j){res+=j;});
+    }
+    return res;
+  })/num_lookups);
+
+  std::vector<std::size_t> removed;
+  for(std::size_t j=0;j<num_members;j+=2)removed.push_back(j);
+  print(name,"filter_bank batch removal (per member)",measure([&]{
+    bank_type b2(b);
+    b2.remove(removed.begin(),removed.end());
+    return b2.size();
+  })/removed.size());
+  print(name,"filter_bank one-by-one removal (per member)",measure([&]{
+    bank_type b2(b);
+    for(auto j:removed)b2.remove(j);
+    return b2.size();
+  })/removed.size());
+
+  std::size_t fp=0;
+  for(auto x:fresh)b.match(x,[&](std::size_t){++fp;});
+  std::cout<<std::setw(12)<<(double)fp/fresh.size()/num_members*100<<
+    "% FPR (expected "<<bank_type::fpr_for(n,m)*100<<"%), "<<name<<"\n";
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of members\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_members=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_members*n;++i)data.push_back(rng());
+  for(std::size_t i=0;i<num_lookups+1;++i)fresh.push_back(rng());
+
+  std::cout<<"members="<<num_members<<", "<<n<<" elements per member, "
+    "times in ns\n";
+  test<3>();
+  test<7>();
+}
@@ -0,0 +1,239 @@
+/* Bulk insertion and lookup with the hash stage executed element by element
+ * (as boost::bloom::filter does) vs. in batches of SIMD-mixed hash values.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Replaces each of the n values pointed to by p with its mulx64 mix.
+ * With AVX2, four values are processed at a time by emulating the
+ * 64x64->128 bit multiplication with four 32x32->64 bit ones.
+ */
+
+void batch_mulx64(std::uint64_t* p,std::size_t n)
+{
+#if defined(BOOST_BLOOM_AVX2)
+  const __m256i c=_mm256_set1_epi64x((long long)0x9E3779B97F4A7C15ull),
+                c_hi=_mm256_srli_epi64(c,32),
+                mask32=_mm256_set1_epi64x(0xFFFFFFFFll);
+
+  for(;n>=4;n-=4,p+=4){
+    __m256i x=_mm256_loadu_si256((const __m256i*)p),
+            x_hi=_mm256_srli_epi64(x,32),
+            ll=_mm256_mul_epu32(x,c),
+            hl=_mm256_mul_epu32(x_hi,c),
+            lh=_mm256_mul_epu32(x,c_hi),
+            hh=_mm256_mul_epu32(x_hi,c_hi),
+            mid=_mm256_add_epi64(
+              _mm256_srli_epi64(ll,32),
+              _mm256_add_epi64(
+                _mm256_and_si256(hl,mask32),_mm256_and_si256(lh,mask32))),
+            lo=_mm256_or_si256(
+              _mm256_slli_epi64(mid,32),_mm256_and_si256(ll,mask32)),
+            hi=_mm256_add_epi64(
+              _mm256_add_epi64(hh,_mm256_srli_epi64(mid,32)),
+              _mm256_add_epi64(
+                _mm256_srli_epi64(hl,32),_mm256_srli_epi64(lh,32)));
+    _mm256_storeu_si256((__m256i*)p,_mm256_xor_si256(hi,lo));
+  }
+#endif
+  for(;n--;++p)*p=boost::bloom::detail::mulx64(*p);
+}
+
+/* Filters with premixed_hash are fed hash values already mixed with
+ * batch_mulx64, and end up with the same contents as their counterparts
+ * using boost::hash<std::uint64_t>.
+ */
+
+struct premixed_hash
+{
+  using is_avalanching=void;
+
+  std::size_t operator()(std::uint64_t x)const{return (std::size_t)x;}
+};
+
+static std::size_t num_elements;
+static const std::size_t batch_size=1024;
+
+struct test_results
+{
+  double insertion_time;         /* ns per element */
+  double batched_insertion_time; /* ns per element */
+  double lookup_time;            /* ns per element */
+  double batched_lookup_time;    /* ns per element */
+};
+
+template<typename Filter>
+test_results test(std::size_t c)
+{
+  using batched_filter=boost::bloom::filter<
+    std::uint64_t,Filter::k,typename Filter::subfilter,Filter::stride,
+    premixed_hash>;
+
+  std::vector<std::uint64_t> data_in,data_out;
+  {
+    boost::detail::splitmix64 rng;
+    for(std::size_t i=0;i<num_elements;++i)data_in.push_back(rng());
+    for(std::size_t i=0;i<num_elements;++i)data_out.push_back(rng());
+  }
+
+  Filter         f(c*num_elements);
+  batched_filter bf(c*num_elements);
+  std::uint64_t  hashes[batch_size];
+
+  auto batched_insert=[&]{
+    for(std::size_t i=0;i<num_elements;i+=batch_size){
+      std::size_t n=(std::min)(batch_size,num_elements-i);
+      std::copy(data_in.begin()+i,data_in.begin()+i+n,hashes);
+      batch_mulx64(hashes,n);
+      bf.insert(hashes,hashes+n);
+    }
+  };
+
+  test_results res;
+  res.insertion_time=measure([&]{
+    f.insert(data_in.begin(),data_in.end());
+    return 0;
+  })/num_elements*1E9;
+  res.batched_insertion_time=measure([&]{
+    batched_insert();
+    return 0;
+  })/num_elements*1E9;
+  if(!std::equal(
+    f.array().begin(),f.array().end(),bf.array().begin())){
+    std::cerr<<"batched insertion produced different results\n";
+    std::exit(EXIT_FAILURE);
+  }
+
+  res.lookup_time=measure([&]{
+    std::size_t res=0;
+    f.may_contain(
+      data_out.begin(),data_out.end(),
+      [&](std::uint64_t,bool b){res+=b;});
+    return res;
+  })/num_elements*1E9;
+  res.batched_lookup_time=measure([&]{
+    std::size_t res=0;
+    for(std::size_t i=0;i<num_elements;i+=batch_size){
+      std::size_t n=(std::min)(batch_size,num_elements-i);
+      std::copy(data_out.begin()+i,data_out.begin()+i+n,hashes);
+      batch_mulx64(hashes,n);
+      bf.may_contain(hashes,hashes+n,[&](std::uint64_t,bool b){res+=b;});
+    }
+    return res;
+  })/num_elements*1E9;
+  return res;
+}
+
+struct print_double
+{
+  print_double(double x_,int precision_=2):x{x_},precision{precision_}{}
+
+  friend std::ostream& operator<<(std::ostream& os,const print_double& pd)
+  {
+    const auto default_precision{std::cout.precision()};
+    os<<std::fixed<<std::setprecision(pd.precision)<<pd.x;
+    std::cout.unsetf(std::ios::fixed);
+    os<<std::setprecision(default_precision);
+    return os;
+  }
+
+  double x;
+  int    precision;
+};
+
+using namespace boost::bloom;
+
+using filters=boost::mp11::mp_list<
+  filter<std::uint64_t,5>,
+  filter<std::uint64_t,1,block<std::uint64_t,4>>,
+  filter<std::uint64_t,1,multiblock<std::uint64_t,8>>,
+  filter<std::uint64_t,1,fast_multiblock64<8>>
+>;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  std::size_t c=12;
+  std::cout<<
+    "c="<<c<<", times in ns per element "
+    "(elementwise hashing / batched hashing)\n";
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,filters>
+  >([&](auto i){
+    using filter=typename decltype(i)::type;
+    auto res=test<filter>(c);
+    std::cout<<
+      "K="<<filter::k<<", subfilter K="<<filter::subfilter::k<<
+      ", stride="<<filter::stride<<"\n"
+      "  insertion: "<<print_double(res.insertion_time)<<" / "<<
+      print_double(res.batched_insertion_time)<<"\n"
+      "  lookup:    "<<print_double(res.lookup_time)<<" / "<<
+      print_double(res.batched_lookup_time)<<"\n";
+  });
+}
@@ -0,0 +1,127 @@
+/* Measures insertion, subtraction and decoding times of
+ * boost::bloom::iblt for sets of n elements with symmetric differences
+ * of varying sizes.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data1,data2;
+
+template<typename Table>
+void test_iblt(const std::string& name,std::size_t d)
+{
+  /* data1 and data2 share all elements but the first d/2 of each */
+
+  std::size_t d1=d/2;
+  std::vector<std::uint64_t> v1(data1.begin(),data1.end()),
+                             v2(data1.begin(),data1.end());
+  std::copy(data2.begin(),data2.begin()+d1,v1.begin());
+  std::copy(data2.begin()+d1,data2.begin()+d,v2.begin());
+
+  double t_insert=measure([&]{
+    Table t(d);
+    t.insert(v1.begin(),v1.end());
+    return t.cell_count();
+  });
+  Table t1(v1.begin(),v1.end(),d),t2(v2.begin(),v2.end(),d);
+  double t_subtract=measure([&]{
+    auto t=t1;
+    t-=t2;
+    return t.cell_count();
+  });
+  auto   t=t1;
+  t-=t2;
+  bool   res=true;
+  double t_decode=measure([&]{
+    std::vector<std::uint64_t> pos,neg;
+    pos.reserve(d);
+    neg.reserve(d);
+    res=t.decode(std::back_inserter(pos),std::back_inserter(neg));
+    return pos.size()+neg.size();
+  });
+
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    name<<", d="<<d<<", "<<t.cell_count()<<" cells"<<
+    (res?"":" (decoding failed)")<<"\n"<<
+    "  insertion:   "<<std::setw(10)<<t_insert/num_elements*1E9<<
+    " ns/element\n"<<
+    "  subtraction: "<<std::setw(10)<<t_subtract/t.cell_count()*1E9<<
+    " ns/cell\n"<<
+    "  decoding:    "<<std::setw(10)<<t_decode/d*1E9<<" ns/element\n";
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data1.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)data2.push_back(rng());
+
+  std::cout<<"n="<<num_elements<<"\n";
+  for(std::size_t d=100;d<=num_elements/10;d*=10){
+    test_iblt<iblt<std::uint64_t>>("iblt<uint64_t>",d);
+    test_iblt<iblt<std::uint64_t,3>>("iblt<uint64_t,3>",d);
+  }
+}
@@ -0,0 +1,142 @@
+/* Bulk lookup time across different proportions of successful lookups.
+ * Compile with -DBOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD=0 (always
+ * branchless), =101 (never branchless) and the default value to compare
+ * the lookup strategies of boost::bloom::filter.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+static std::size_t num_elements;
+static const double hit_ratios[]={0.0,0.1,0.25,0.5,0.75,0.9,1.0};
+
+template<typename Filter>
+void test(std::size_t c)
+{
+  std::vector<std::uint64_t> data_in,data_out;
+  boost::detail::splitmix64  rng;
+  for(std::size_t i=0;i<num_elements;++i)data_in.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)data_out.push_back(rng());
+
+  Filter f(c*num_elements);
+  f.insert(data_in.begin(),data_in.end());
+
+  for(double hit_ratio:hit_ratios){
+    const std::uint64_t cut=
+      (std::uint64_t)(
+        hit_ratio*(double)(std::numeric_limits<std::uint64_t>::max)());
+    std::vector<std::uint64_t> data_mixed;
+    for(std::size_t i=0;i<num_elements;++i){
+      data_mixed.push_back(
+        hit_ratio==1.0||rng()<cut?data_in[i]:data_out[i]);
+    }
+
+    double t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(
+        data_mixed.begin(),data_mixed.end(),
+        [&](std::uint64_t,bool b){res+=b;});
+      return res;
+    })/num_elements*1E9;
+    std::cout<<std::fixed<<std::setprecision(2)<<std::setw(8)<<t;
+  }
+  std::cout<<"\n";
+}
+
+using namespace boost::bloom;
+
+using filters=boost::mp11::mp_list<
+  filter<std::uint64_t,5>,
+  filter<std::uint64_t,8>,
+  filter<std::uint64_t,3,block<std::uint64_t,2>>,
+  filter<std::uint64_t,2,multiblock<std::uint64_t,3>>,
+  filter<std::uint64_t,2,fast_multiblock32<4>>
+>;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  std::size_t c=12;
+  std::cout<<
+    "c="<<c<<", BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD="<<
+    BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD<<
+    ", lookup times in ns per element\n"
+    "successful lookups [%]:";
+  for(double hit_ratio:hit_ratios){
+    std::cout<<std::setw(8)<<(int)(hit_ratio*100);
+  }
+  std::cout<<"\n";
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,filters>
+  >([&](auto i){
+    using filter=typename decltype(i)::type;
+    std::cout<<
+      "K="<<filter::k<<", subfilter K="<<std::setw(2)<<filter::subfilter::k<<
+      "       ";
+    test<filter>(c);
+  });
+}
@@ -0,0 +1,301 @@
+/* Measures memory usage and speed of many configurations of
+ * boost::bloom::filter for a given number of elements and target FPR, and
+ * prints the Pareto frontier of memory vs. ns/op along with the fastest
+ * configuration meeting an optional memory budget.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start,measure_pause;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+void pause_timing()
+{
+  measure_pause=std::chrono::high_resolution_clock::now();
+}
+
+void resume_timing()
+{
+  measure_start+=std::chrono::high_resolution_clock::now()-measure_pause;
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+/* workload description */
+
+static std::size_t num_elements;
+static double      target_fpr;
+static double      lookups_per_insertion=1.0;
+static double      successful_lookup_proportion=0.1;
+static std::size_t memory_budget=(std::numeric_limits<std::size_t>::max)();
+
+static std::vector<int> data_in,data_mixed;
+
+void make_data()
+{
+  const std::uint64_t mixed_lookup_cut=
+    (std::uint64_t)(
+      successful_lookup_proportion*
+      (double)(std::numeric_limits<std::uint64_t>::max)());
+
+  /* duplicates are harmless for the purposes of this program */
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data_in.push_back((int)rng());
+  for(std::size_t i=0;i<num_elements;++i){
+    data_mixed.push_back(rng()<mixed_lookup_cut?data_in[i]:(int)rng());
+  }
+}
+
+/* configuration names */
+
+template<typename T> struct type_name;
+template<> struct type_name<unsigned char>
+{static std::string get(){return "unsigned char";}};
+template<> struct type_name<std::uint32_t>
+{static std::string get(){return "uint32_t";}};
+template<> struct type_name<std::uint64_t>
+{static std::string get(){return "uint64_t";}};
+template<typename T,std::size_t N> struct type_name<T[N]>
+{static std::string get(){return type_name<T>::get()+"["+std::to_string(N)+"]";}};
+
+template<typename Subfilter> struct subfilter_name;
+template<typename B,std::size_t K>
+struct subfilter_name<boost::bloom::block<B,K>>
+{
+  static std::string get()
+  {
+    return "block<"+type_name<B>::get()+","+std::to_string(K)+">";
+  }
+};
+template<typename B,std::size_t K>
+struct subfilter_name<boost::bloom::multiblock<B,K>>
+{
+  static std::string get()
+  {
+    return "multiblock<"+type_name<B>::get()+","+std::to_string(K)+">";
+  }
+};
+template<std::size_t K>
+struct subfilter_name<boost::bloom::fast_multiblock32<K>>
+{
+  static std::string get()
+  {
+    return "fast_multiblock32<"+std::to_string(K)+">";
+  }
+};
+template<std::size_t K>
+struct subfilter_name<boost::bloom::fast_multiblock64<K>>
+{
+  static std::string get()
+  {
+    return "fast_multiblock64<"+std::to_string(K)+">";
+  }
+};
+
+template<typename Filter>
+std::string filter_name()
+{
+  return
+    "filter<int,"+std::to_string(Filter::k)+","+
+    subfilter_name<typename Filter::subfilter>::get()+","+
+    std::to_string(Filter::stride)+">";
+}
+
+/* measurement */
+
+struct result
+{
+  std::string name;
+  std::size_t memory;         /* bytes */
+  double      fpr;            /* estimated */
+  double      insertion_time; /* ns per element */
+  double      lookup_time;    /* ns per element */
+  double      op_time;        /* ns per op, weighted by workload */
+  bool        pareto;
+};
+
+static std::vector<result> results;
+
+template<typename Filter>
+void test()
+{
+  std::size_t m=Filter::capacity_for(num_elements,target_fpr);
+  if(m/CHAR_BIT>memory_budget*4)return; /* too far off, don't bother */
+
+  result res;
+  res.name=filter_name<Filter>();
+  res.memory=m/CHAR_BIT;
+  res.fpr=Filter::fpr_for(num_elements,m);
+
+  res.insertion_time=measure([&]{
+    pause_timing();
+    {
+      Filter f(m);
+      resume_timing();
+      f.insert(data_in.begin(),data_in.end());
+      pause_timing();
+    }
+    resume_timing();
+    return 0;
+  })/num_elements*1E9;
+
+  Filter f(m);
+  f.insert(data_in.begin(),data_in.end());
+  res.lookup_time=measure([&]{
+    std::size_t n=0;
+    f.may_contain(
+      data_mixed.begin(),data_mixed.end(),[&](int,bool b){n+=b;});
+    return n;
+  })/num_elements*1E9;
+
+  res.op_time=
+    (res.insertion_time+lookups_per_insertion*res.lookup_time)/
+    (1.0+lookups_per_insertion);
+  res.pareto=false;
+  results.push_back(res);
+  std::cerr<<"."<<std::flush;
+}
+
+/* candidate configurations */
+
+using namespace boost::bloom;
+
+template<std::size_t K>
+using candidates_for_k=boost::mp11::mp_list<
+  filter<int,K>,
+  filter<int,1,block<std::uint64_t,K>>,
+  filter<int,1,block<std::uint64_t,K>,1>,
+  filter<int,1,multiblock<std::uint64_t,K>>,
+  filter<int,1,multiblock<std::uint64_t,K>,1>,
+  filter<int,1,fast_multiblock32<K>>,
+  filter<int,1,fast_multiblock64<K>>,
+  filter<int,1,block<std::uint64_t[8],K>>,
+  filter<int,1,multiblock<std::uint64_t[8],K>>
+>;
+
+template<typename I>
+using candidates_for_index=candidates_for_k<I::value+1>;
+
+using candidates=boost::mp11::mp_flatten<
+  boost::mp11::mp_transform<
+    candidates_for_index,boost::mp11::mp_iota_c<16>>>;
+
+int main(int argc,char* argv[])
+{
+  if(argc<3){
+    std::cerr<<
+      "usage: pareto_frontier n fpr [lookups per insertion] "
+      "[successful lookup proportion] [memory budget in bytes]\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+    target_fpr=std::stod(argv[2]);
+    if(argc>3)lookups_per_insertion=std::stod(argv[3]);
+    if(argc>4)successful_lookup_proportion=std::stod(argv[4]);
+    if(argc>5)memory_budget=std::stoul(argv[5]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+  if(memory_budget>(std::numeric_limits<std::size_t>::max)()/4){
+    memory_budget=(std::numeric_limits<std::size_t>::max)()/4;
+  }
+
+  make_data();
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,candidates>
+  >([&](auto i){
+    test<typename decltype(i)::type>();
+  });
+  std::cerr<<"\n";
+
+  /* a configuration is in the frontier if no other one uses no more memory
+   * and is faster.
+   */
+
+  std::sort(results.begin(),results.end(),[](const result& x,const result& y){
+    return x.memory<y.memory||(x.memory==y.memory&&x.op_time<y.op_time);
+  });
+  double best_time=(std::numeric_limits<double>::max)();
+  for(auto& res:results){
+    if(res.op_time<best_time){
+      res.pareto=true;
+      best_time=res.op_time;
+    }
+  }
+
+  std::cout<<
+    "n="<<num_elements<<", target FPR="<<target_fpr<<
+    ", lookups per insertion="<<lookups_per_insertion<<
+    ", successful lookups="<<successful_lookup_proportion*100<<"%\n"
+    "memory [bytes]  FPR [%]  ins. [ns]  lkp. [ns]  op [ns]  configuration\n";
+  const result* recommended=nullptr;
+  for(const auto& res:results){
+    if(!res.pareto)continue;
+    std::cout<<std::fixed<<
+      std::setw(14)<<res.memory<<
+      std::setw(9)<<std::setprecision(4)<<res.fpr*100<<
+      std::setw(11)<<std::setprecision(2)<<res.insertion_time<<
+      std::setw(11)<<res.lookup_time<<
+      std::setw(9)<<res.op_time<<"  "<<res.name<<"\n";
+    if(res.memory<=memory_budget)recommended=&res;
+  }
+  if(recommended){
+    std::cout<<"recommended: "<<recommended->name<<"\n";
+  }
+  else{
+    std::cout<<"no configuration meets the memory budget\n";
+  }
+}
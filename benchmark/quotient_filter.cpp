@@ -0,0 +1,153 @@
+/* Compares insertion, lookup and erasure times of boost::bloom::quotient_filter
+ * with those of boost::bloom::filter, and measures the times of resizing
+ * and merging quotient filters.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data_in,data_out;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t/num_elements*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+template<typename Filter>
+void test_lookup(const std::string& name,const Filter& f)
+{
+  print(name,"successful lookup",measure([&]{
+    std::size_t n=0;
+    f.may_contain(
+      data_in.begin(),data_in.end(),[&](std::uint64_t,bool b){n+=b;});
+    return n;
+  }));
+  print(name,"unsuccessful lookup",measure([&]{
+    std::size_t n=0;
+    f.may_contain(
+      data_out.begin(),data_out.end(),[&](std::uint64_t,bool b){n+=b;});
+    return n;
+  }));
+}
+
+template<typename Filter>
+void test_filter(const std::string& name,double fpr)
+{
+  print(name,"insertion",measure([&]{
+    Filter f(num_elements,fpr);
+    f.insert(data_in.begin(),data_in.end());
+    return f.capacity();
+  }));
+  Filter f(data_in.begin(),data_in.end(),num_elements,fpr);
+  test_lookup(name,f);
+}
+
+template<typename Filter>
+void test_quotient_filter(const std::string& name)
+{
+  print(name,"insertion",measure([&]{
+    Filter f(num_elements);
+    f.insert(data_in.begin(),data_in.end());
+    return f.capacity();
+  }));
+  Filter f(data_in.begin(),data_in.end(),num_elements);
+  std::cout<<"            FPR="<<std::setprecision(4)<<f.fpr()*100<<"%\n";
+  test_lookup(name,f);
+  print(name,"insertion+erasure",measure([&]{
+    Filter f(num_elements);
+    f.insert(data_in.begin(),data_in.end());
+    f.erase(data_in.begin(),data_in.end());
+    return f.size();
+  }));
+  print(name,"resize",measure([&]{
+    auto f2=f;
+    f2.resize();
+    return f2.capacity();
+  }));
+
+  std::size_t n=num_elements/2;
+  Filter      f1(data_in.begin(),data_in.begin()+n,n),
+              f2(data_in.begin()+n,data_in.end(),n);
+  print(name,"merge",measure([&]{
+    auto f3=f1;
+    f3.merge(f2);
+    return f3.capacity();
+  }));
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data_in.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)data_out.push_back(rng());
+
+  std::cout<<"n="<<num_elements<<", times in ns per element\n";
+  test_filter<filter<std::uint64_t,1,fast_multiblock32<7>>>(
+    "filter<uint64_t,1,fast_multiblock32<7>>",0.005);
+  test_quotient_filter<quotient_filter<std::uint64_t,8>>(
+    "quotient_filter<uint64_t,8>");
+  test_quotient_filter<quotient_filter<std::uint64_t,16>>(
+    "quotient_filter<uint64_t,16>");
+}
@@ -0,0 +1,160 @@
+/* Measures insertion, point lookup and range lookup times of
+ * boost::bloom::range_filter for short ranges, along with the empirical FPR
+ * of empty ranges.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using range=std::pair<std::uint64_t,std::uint64_t>;
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data,
+                                  fresh;
+static std::vector<range>         ranges;
+static std::size_t                num_empty_ranges;
+
+static constexpr std::uint64_t max_range_width=64,
+                               range_width=16;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t/num_elements*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+template<typename Filter>
+Filter make_filter()
+{
+  return Filter(num_elements,0.01,max_range_width);
+}
+
+template<typename Filter>
+void test(const std::string& name)
+{
+  print(name,"insertion",measure([&]{
+    auto f=make_filter<Filter>();
+    for(auto x:data)f.insert(x);
+    return f.capacity();
+  }));
+  print(name,"bulk insertion",measure([&]{
+    auto f=make_filter<Filter>();
+    f.insert(data.begin(),data.end());
+    return f.capacity();
+  }));
+  auto f=make_filter<Filter>();
+  f.insert(data.begin(),data.end());
+  print(name,"point lookup",measure([&]{
+    std::size_t res=0;
+    for(auto x:fresh)res+=f.may_contain(x);
+    return res;
+  }));
+  print(name,"range lookup",measure([&]{
+    std::size_t res=0;
+    for(const auto& r:ranges)res+=f.may_contain_range(r.first,r.second);
+    return res;
+  }));
+  print(name,"bulk range lookup",measure([&]{
+    std::size_t res=0;
+    f.may_contain_range(
+      ranges.begin(),ranges.end(),[&](const range&,bool b){res+=b;});
+    return res;
+  }));
+  std::size_t positives=0;
+  for(const auto& r:ranges)positives+=f.may_contain_range(r.first,r.second);
+  std::cout<<std::setw(10)<<
+    (double)(positives-(ranges.size()-num_empty_ranges))/
+      num_empty_ranges*100<<
+    "% FPR of empty ranges, "<<f.capacity()/num_elements<<
+    " bits per key, "<<name<<"\n";
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  /* keys spread so that most ranges are empty */
+
+  boost::detail::splitmix64 rng;
+  std::uint64_t             domain=num_elements*range_width*64;
+  std::set<std::uint64_t>   keys;
+  for(std::size_t i=0;i<num_elements;++i){
+    data.push_back(rng()%domain);
+    keys.insert(data.back());
+  }
+  for(std::size_t i=0;i<num_elements;++i){
+    fresh.push_back(rng()%domain);
+    std::uint64_t a=rng()%domain;
+    ranges.push_back({a,a+range_width-1});
+    auto it=keys.lower_bound(a);
+    num_empty_ranges+=it==keys.end()||*it>a+range_width-1;
+  }
+
+  std::cout<<"n="<<num_elements<<", times in ns per element, "<<
+    "ranges of width "<<range_width<<"\n";
+  test<range_filter<std::uint64_t,7>>("range_filter<uint64_t,7>");
+  test<range_filter<std::uint64_t,1,block<std::uint64_t,7>>>(
+    "range_filter<uint64_t,1,block<uint64_t,7>>");
+  test<range_filter<std::uint64_t,1,fast_multiblock64<7>>>(
+    "range_filter<uint64_t,1,fast_multiblock64<7>>");
+}
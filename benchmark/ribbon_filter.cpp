@@ -0,0 +1,170 @@
+/* Memory, construction and lookup time of boost::bloom::ribbon_filter vs.
+ * boost::bloom::filter for a static set at similar FPRs.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+std::chrono::high_resolution_clock::time_point measure_start;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    measure_start=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-measure_start<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-measure_start).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data_in,data_out;
+
+struct test_results
+{
+  double bits_per_element;
+  double fpr;               /* measured */
+  double construction_time; /* ns per element */
+  double lookup_time;       /* ns per element, successful lookups */
+  double negative_time;     /* ns per element, unsuccessful lookups */
+};
+
+template<typename Filter,typename Builder>
+test_results test(Builder build)
+{
+  test_results res;
+  res.construction_time=measure([&]{
+    auto f=build();
+    return f.capacity();
+  })/num_elements*1E9;
+
+  auto f=build();
+  res.bits_per_element=(double)f.capacity()/num_elements;
+  std::size_t fp=0;
+  for(const auto& x:data_out)fp+=f.may_contain(x);
+  res.fpr=(double)fp/num_elements;
+
+  res.lookup_time=measure([&]{
+    std::size_t n=0;
+    f.may_contain(
+      data_in.begin(),data_in.end(),[&](std::uint64_t,bool b){n+=b;});
+    return n;
+  })/num_elements*1E9;
+  res.negative_time=measure([&]{
+    std::size_t n=0;
+    f.may_contain(
+      data_out.begin(),data_out.end(),[&](std::uint64_t,bool b){n+=b;});
+    return n;
+  })/num_elements*1E9;
+  return res;
+}
+
+void print(const std::string& name,const test_results& res)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<res.bits_per_element<<
+    std::setw(10)<<res.fpr*100<<
+    std::setw(10)<<res.construction_time<<
+    std::setw(10)<<res.lookup_time<<
+    std::setw(10)<<res.negative_time<<"  "<<name<<"\n";
+}
+
+template<typename Filter>
+void test_filter(const std::string& name,double fpr)
+{
+  print(name,test<Filter>([&]{
+    return Filter(data_in.begin(),data_in.end(),num_elements,fpr);
+  }));
+}
+
+template<typename Filter>
+void test_ribbon_filter(const std::string& name,std::size_t num_threads)
+{
+  print(name+", "+std::to_string(num_threads)+" thread(s)",test<Filter>([&]{
+    return Filter(data_in.begin(),data_in.end(),num_threads);
+  }));
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data_in.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)data_out.push_back(rng());
+
+  std::size_t num_threads=std::thread::hardware_concurrency();
+  if(num_threads==0)num_threads=1;
+
+  std::cout<<
+    "n="<<num_elements<<", times in ns per element\n"
+    "bits/elem   FPR [%]     build  lkp.pos.  lkp.neg.  configuration\n";
+  test_filter<filter<std::uint64_t,1,fast_multiblock32<7>>>(
+    "filter<uint64_t,1,fast_multiblock32<7>>",0.01);
+  test_filter<filter<std::uint64_t,1,block<std::uint64_t,7>,1>>(
+    "filter<uint64_t,1,block<uint64_t,7>,1>",0.01);
+  test_ribbon_filter<ribbon_filter<std::uint64_t,7>>(
+    "ribbon_filter<uint64_t,7>",1);
+  if(num_threads>1){
+    test_ribbon_filter<ribbon_filter<std::uint64_t,7>>(
+      "ribbon_filter<uint64_t,7>",num_threads);
+  }
+  test_filter<filter<std::uint64_t,1,fast_multiblock32<10>>>(
+    "filter<uint64_t,1,fast_multiblock32<10>>",0.001);
+  test_ribbon_filter<ribbon_filter<std::uint64_t,10>>(
+    "ribbon_filter<uint64_t,10>",1);
+  if(num_threads>1){
+    test_ribbon_filter<ribbon_filter<std::uint64_t,10>>(
+      "ribbon_filter<uint64_t,10>",num_threads);
+  }
+}
@@ -0,0 +1,139 @@
+/* Measures insertion and lookup times of boost::bloom::stable_filter for
+ * a stream of distinct elements, along with the empirical FPR, compared
+ * with a classical filter using the same amount of memory.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  static const int              num_trials=10;
+  static const milliseconds     min_time_per_trial(10);
+  std::array<double,num_trials> trials;
+
+  for(int i=0;i<num_trials;++i){
+    int                               runs=0;
+    high_resolution_clock::time_point t2;
+    volatile decltype(f())            res; /* to avoid optimizing f() away */
+
+    auto t1=high_resolution_clock::now();
+    do{
+      res=f();
+      ++runs;
+      t2=high_resolution_clock::now();
+    }while(t2-t1<min_time_per_trial);
+    trials[i]=duration_cast<duration<double>>(t2-t1).count()/runs;
+  }
+
+  std::sort(trials.begin(),trials.end());
+  return std::accumulate(
+    trials.begin()+2,trials.end()-2,0.0)/(trials.size()-4);
+}
+
+#include <boost/bloom.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::size_t                num_elements;
+static std::vector<std::uint64_t> data,
+                                  fresh;
+
+void print(const std::string& name,const std::string& op,double t)
+{
+  std::cout<<std::fixed<<std::setprecision(2)<<
+    std::setw(10)<<t/num_elements*1E9<<"  "<<op<<", "<<name<<"\n";
+}
+
+/* 4 bits of memory per element of the stream */
+
+template<typename Filter>
+Filter make_filter()
+{
+  return Filter(num_elements*4,Filter::decrements_for(0.01));
+}
+
+template<typename Filter>
+void test(const std::string& name)
+{
+  print(name,"insertion",measure([&]{
+    auto f=make_filter<Filter>();
+    for(auto x:data)f.insert(x);
+    return f.capacity();
+  }));
+  print(name,"bulk insertion",measure([&]{
+    auto f=make_filter<Filter>();
+    f.insert(data.begin(),data.end());
+    return f.capacity();
+  }));
+  auto f=make_filter<Filter>();
+  f.insert(data.begin(),data.end());
+  print(name,"lookup",measure([&]{
+    std::size_t res=0;
+    for(auto x:fresh)res+=f.may_contain(x);
+    return res;
+  }));
+  print(name,"bulk lookup",measure([&]{
+    std::size_t res=0;
+    f.may_contain(
+      fresh.begin(),fresh.end(),[&](std::uint64_t,bool b){res+=b;});
+    return res;
+  }));
+  std::size_t fp=0;
+  for(auto x:fresh)fp+=f.may_contain(x);
+  std::cout<<std::setw(10)<<(double)fp/fresh.size()*100<<
+    "% FPR (expected "<<f.fpr()*100<<"%), "<<name<<"\n";
+}
+
+using namespace boost::bloom;
+
+struct classical_filter:filter<std::uint64_t,1,block<std::uint64_t[8],3>>
+{
+  using super=filter<std::uint64_t,1,block<std::uint64_t[8],3>>;
+
+  classical_filter(std::size_t m,std::size_t):super(m){}
+  static std::size_t decrements_for(double){return 0;}
+  double fpr()const{return super::fpr_for(num_elements,capacity());}
+};
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)fresh.push_back(rng());
+
+  std::cout<<"n="<<num_elements<<", times in ns per element\n";
+  test<classical_filter>("filter<uint64_t,1,block<uint64_t[8],3>>");
+  test<stable_filter<std::uint64_t,3>>("stable_filter<uint64_t,3>");
+  test<stable_filter<std::uint64_t,4,4>>("stable_filter<uint64_t,4,4>");
+  test<stable_filter<std::uint64_t,2,1>>("stable_filter<uint64_t,2,1>");
+}
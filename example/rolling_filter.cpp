@@ -33,6 +33,9 @@
  * resulting FPR oscillates between 1 - (1 - sub_fpr)^(n-1) and 
  * 1 - (1 - sub_fpr)^n, where sub_fpr is the FPR of an individual filter
  * after w insertions.
+ * 
+ * When there is no natural window size, boost::bloom::stable_filter offers
+ * a single-array alternative whose FPR converges to a fixed value instead.
  */
 
 template<
@@ -14,5 +14,19 @@
 #include <boost/bloom/multiblock.hpp>
 #include <boost/bloom/fast_multiblock32.hpp>
 #include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/bloom/sectorized_block.hpp>
+#include <boost/bloom/lookup_pipeline.hpp>
+#include <boost/bloom/sharded_filter.hpp>
+#include <boost/bloom/cascaded_filter.hpp>
+#include <boost/bloom/ribbon_filter.hpp>
+#include <boost/bloom/quotient_filter.hpp>
+#include <boost/bloom/iblt.hpp>
+#include <boost/bloom/count_min_sketch.hpp>
+#include <boost/bloom/stable_filter.hpp>
+#include <boost/bloom/age_partitioned_filter.hpp>
+#include <boost/bloom/range_filter.hpp>
+#include <boost/bloom/filter_bank.hpp>
+#include <boost/bloom/filter_arena.hpp>
+#include <boost/bloom/string_hash.hpp>
 
 #endif
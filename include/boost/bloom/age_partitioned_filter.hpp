@@ -0,0 +1,373 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_AGE_PARTITIONED_FILTER_HPP
+#define BOOST_BLOOM_AGE_PARTITIONED_FILTER_HPP
+
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/age_partitioned_block.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Age-partitioned Bloom filter (Shtul, Baquero and Almeida, 2020). The
+ * filter is divided into K+L slices; elements are inserted into the K
+ * youngest slices and looked up as present if found in any K consecutive
+ * slices. On each generation shift, slices age by one position and the
+ * oldest one is cleared and reused as the youngest, so that an element is
+ * remembered for L shifts after its insertion. Slices are interleaved at
+ * the word level in blocks held by a filter_core (see
+ * age_partitioned_block), which makes insertion and lookup touch one
+ * contiguous block, and shifting amounts to rotating a base index plus
+ * clearing one word per block.
+ */
+
+template<
+  typename T,std::size_t K,std::size_t L,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class age_partitioned_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using block_type=detail::age_partitioned_block<K,L>;
+  using core_type=detail::filter_core<1,block_type,0,Allocator>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  static constexpr std::size_t l=L;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=core_type::bulk_insert_size;
+  static constexpr std::size_t bulk_may_contain_size=
+    core_type::bulk_may_contain_size;
+
+  explicit age_partitioned_filter(
+    std::size_t m=0,std::size_t g=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},core{m,al},generation_size_{g}{}
+
+  age_partitioned_filter(std::size_t m,const allocator_type& al):
+    age_partitioned_filter{m,0,hasher(),al}{}
+
+  age_partitioned_filter(
+    std::size_t m,std::size_t g,const allocator_type& al):
+    age_partitioned_filter{m,g,hasher(),al}{}
+
+  template<typename InputIterator>
+  age_partitioned_filter(
+    InputIterator first,InputIterator last,
+    std::size_t m,std::size_t g=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    age_partitioned_filter{m,g,h,al}
+  {
+    insert(first,last);
+  }
+
+  age_partitioned_filter(
+    std::initializer_list<value_type> il,
+    std::size_t m,std::size_t g=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    age_partitioned_filter{il.begin(),il.end(),m,g,h,al}{}
+
+  age_partitioned_filter(const age_partitioned_filter&)=default;
+  age_partitioned_filter(age_partitioned_filter&&)=default;
+  age_partitioned_filter& operator=(const age_partitioned_filter&)=default;
+  age_partitioned_filter& operator=(age_partitioned_filter&&)=default;
+
+  allocator_type get_allocator()const noexcept
+  {
+    return core.get_allocator();
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return core.capacity();
+  }
+
+  std::size_t generation_size()const noexcept
+  {
+    return generation_size_;
+  }
+
+  /* Slices are sized so that they are half full when they leave the K
+   * youngest positions, as recommended by the authors.
+   */
+
+  static std::size_t capacity_for(std::size_t g)
+  {
+    if(g==0)return 0;
+    return num_slices*(std::size_t)std::ceil((double)(K*g)/std::log(2.0));
+  }
+
+  /* FPR right before a shift, when it is highest, for a filter with
+   * capacity m shifted every g insertions: logical slice i then holds
+   * min(i+1,K) generations, and a false positive occurs if any K
+   * consecutive slices have the element's bits set.
+   */
+
+  static double fpr_for(std::size_t g,std::size_t m)
+  {
+    if(m==0)return 1.0;
+    double      slice_bits=(double)(m/num_slices),
+                no_run[K]={1.0}; /* by length of trailing run of hits */
+    std::size_t generations=0;
+    for(std::size_t i=0;i<num_slices;++i){
+      if(generations<K)++generations;
+      double fill=1.0-std::exp(-(double)(generations*g)/slice_bits),
+             miss=0.0;
+      for(std::size_t r=K;r--;){
+        miss+=no_run[r];
+        no_run[r]=r?no_run[r-1]*fill:0.0;
+      }
+      no_run[0]=miss*(1.0-fill);
+    }
+    double res=1.0;
+    for(std::size_t r=0;r<K;++r)res-=no_run[r];
+    return res;
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  /* Blocks of the next bulk_insert_size elements are prefetched while the
+   * current one is updated. Elements are processed in order, shifts
+   * included, so the result is the same as with one-by-one insertion.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    if(!capacity())return;
+
+    std::uint64_t  hashes[bulk_insert_size];
+    unsigned char* positions[bulk_insert_size];
+    std::size_t    n=0;
+    for(;n<bulk_insert_size&&first!=last;++first,++n){
+      auto& hash=hashes[n]=hash_for(*first);
+      positions[n]=core.start_insert(hash);
+    }
+    std::size_t i=0;
+    for(;first!=last;++first){
+      set(positions[i],hashes[i]);
+      auto& hash=hashes[i]=hash_for(*first);
+      positions[i]=core.start_insert(hash);
+      if(++i==bulk_insert_size)i=0;
+    }
+    for(std::size_t j=0;j<n;++j){
+      set(positions[i],hashes[i]);
+      if(++i==bulk_insert_size)i=0;
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  /* Ages all slices by one position and clears the oldest one, which
+   * becomes the youngest.
+   */
+
+  void shift()noexcept
+  {
+    base=(base+num_slices-1)%num_slices;
+    auto p=reinterpret_cast<std::uint64_t*>(core.array().data())+base;
+    for(auto n=core.array().size()/sizeof(block_value_type);n--;){
+      *p=0;
+      p+=num_slices;
+    }
+    insertions=0;
+  }
+
+  void swap(age_partitioned_filter& x)
+    noexcept(noexcept(std::declval<core_type&>().swap(
+      std::declval<core_type&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    core.swap(x.core);
+    swap(h(),x.h());
+    swap(generation_size_,x.generation_size_);
+    swap(base,x.base);
+    swap(insertions,x.insertions);
+  }
+
+  void clear()noexcept
+  {
+    core.clear();
+    base=0;
+    insertions=0;
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  /* Blocks of a chunk of elements are prefetched before any of them is
+   * checked.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    if(!capacity()){
+      for(;first!=last;++first)f(*first,true);
+      return;
+    }
+
+    std::uint64_t        hashes[bulk_may_contain_size];
+    const unsigned char* positions[bulk_may_contain_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(auto it=first;n<bulk_may_contain_size&&it!=last;++it,++n){
+        auto& hash=hashes[n]=hash_for(*it);
+        positions[n]=core.start_may_contain(hash);
+      }
+      for(std::size_t i=0;i<n;++i,++first){
+        f(*first,get(positions[i],hashes[i]));
+      }
+    }
+  }
+
+private:
+  template<
+    typename T1,std::size_t K1,std::size_t L1,typename H1,typename A1
+  >
+  bool friend operator==(
+    const age_partitioned_filter<T1,K1,L1,H1,A1>& x,
+    const age_partitioned_filter<T1,K1,L1,H1,A1>& y);
+
+  using hash_base=empty_value<Hash,0>;
+  using block_value_type=typename block_type::value_type;
+  static constexpr std::size_t num_slices=block_type::num_slices;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    if(!capacity())return;
+    auto p=core.start_insert(hash);
+    set(p,hash);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    if(!capacity())return true;
+    auto p=core.start_may_contain(hash);
+    return get(p,hash);
+  }
+
+  BOOST_FORCEINLINE void set(unsigned char* p,std::uint64_t hash)
+  {
+    block_type::mark(*reinterpret_cast<block_value_type*>(p),hash,base);
+    if(generation_size_&&++insertions==generation_size_)shift();
+  }
+
+  BOOST_FORCEINLINE bool get(const unsigned char* p,std::uint64_t hash)const
+  {
+    return block_type::check(
+      *reinterpret_cast<const block_value_type*>(p),hash,base);
+  }
+
+  core_type   core;
+  std::size_t generation_size_;
+  std::size_t base=0;
+  std::size_t insertions=0;
+};
+
+template<typename T,std::size_t K,std::size_t L,typename H,typename A>
+bool operator==(
+  const age_partitioned_filter<T,K,L,H,A>& x,
+  const age_partitioned_filter<T,K,L,H,A>& y)
+{
+  return x.core==y.core&&x.base==y.base;
+}
+
+template<typename T,std::size_t K,std::size_t L,typename H,typename A>
+bool operator!=(
+  const age_partitioned_filter<T,K,L,H,A>& x,
+  const age_partitioned_filter<T,K,L,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,std::size_t K,std::size_t L,typename H,typename A>
+void swap(
+  age_partitioned_filter<T,K,L,H,A>& x,age_partitioned_filter<T,K,L,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
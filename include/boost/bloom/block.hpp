@@ -12,6 +12,7 @@
 #include <boost/bloom/detail/block_base.hpp>
 #include <boost/bloom/detail/block_ops.hpp>
 #include <boost/bloom/detail/block_fpr_base.hpp>
+#include <boost/bloom/detail/block_vertical_check.hpp>
 #include <cstddef>
 #include <cstdint>
 
@@ -21,6 +22,7 @@ namespace bloom{
 template<typename Block,std::size_t K>
 struct block:
   public detail::block_fpr_base<K>,
+  public detail::block_vertical_check<Block,K>,
   private detail::block_base<Block,K>
 {
   static constexpr std::size_t k=K;
@@ -0,0 +1,339 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_CASCADED_FILTER_HPP
+#define BOOST_BLOOM_CASCADED_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* cascaded_filter keeps, alongside the main array, a smaller front
+ * array with the same elements that is checked first on lookup, so that
+ * most negative queries are resolved without touching the main array.
+ * Positions in the front array are derived from a mulx64 remix of the
+ * element hash, which makes front and main lookups independent.
+ * By default, the front array gets 1/front_capacity_ratio of the bits of
+ * the main array, on top of them, up to front_cache_size bytes so that it
+ * stays L2-resident. With about one bit per element, a single-bit
+ * FrontSubfilter is the best choice.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>,
+  std::size_t FrontK=1,typename FrontSubfilter=block<std::uint64_t,1>
+>
+class cascaded_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using core_type=detail::filter_core<K,Subfilter,Stride,Allocator>;
+  using front_core_type=
+    detail::filter_core<FrontK,FrontSubfilter,0,Allocator>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=core_type::k;
+  using subfilter=typename core_type::subfilter;
+  static constexpr std::size_t stride=core_type::stride;
+  static constexpr std::size_t front_k=front_core_type::k;
+  using front_subfilter=typename front_core_type::subfilter;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t front_capacity_ratio=16;
+  static constexpr std::size_t front_cache_size=1024*1024;
+  static constexpr std::size_t bulk_insert_size=
+    4*core_type::bulk_insert_size;
+  static constexpr std::size_t bulk_may_contain_size=
+    4*core_type::bulk_may_contain_size;
+
+  explicit cascaded_filter(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    cascaded_filter{m,default_front_capacity(m),h,al}{}
+
+  cascaded_filter(
+    std::size_t m,std::size_t front_m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},main{m,al},front{m?front_m:0,al}{}
+
+  template<typename InputIterator>
+  cascaded_filter(
+    InputIterator first,InputIterator last,
+    std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    cascaded_filter{m,h,al}
+  {
+    insert(first,last);
+  }
+
+  cascaded_filter(const cascaded_filter&)=default;
+  cascaded_filter(cascaded_filter&&)=default;
+  cascaded_filter& operator=(const cascaded_filter&)=default;
+  cascaded_filter& operator=(cascaded_filter&&)=default;
+
+  allocator_type get_allocator()const noexcept
+  {
+    return main.get_allocator();
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return main.capacity();
+  }
+
+  std::size_t front_capacity()const noexcept
+  {
+    return front.capacity();
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  /* Hashes are calculated once per chunk and then fed to the bulk
+   * insertion routines of both arrays.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    if(!capacity())return;
+
+    bool          use_front=front_capacity()!=0;
+    std::uint64_t hashes[bulk_insert_size];
+    while(first!=last){
+      std::size_t n=0;
+      do{
+        hashes[n++]=promoting_hash_for(*first);
+        ++first;
+      }while(n<bulk_insert_size&&first!=last);
+      const std::uint64_t* p=hashes;
+      main.bulk_insert([&p]{return *p++;},n);
+      if(use_front){
+        p=hashes;
+        front.bulk_insert([&p]{return front_hash(*p++);},n);
+      }
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void clear()noexcept
+  {
+    main.clear();
+    front.clear();
+  }
+
+  void reset(std::size_t m=0)
+  {
+    reset(m,default_front_capacity(m));
+  }
+
+  void reset(std::size_t m,std::size_t front_m)
+  {
+    main.reset(m);
+    front.reset(m?front_m:0);
+  }
+
+  cascaded_filter& operator&=(const cascaded_filter& x)
+  {
+    check_compatible(x);
+    main&=x.main;
+    front&=x.front;
+    return *this;
+  }
+
+  cascaded_filter& operator|=(const cascaded_filter& x)
+  {
+    check_compatible(x);
+    main|=x.main;
+    front|=x.front;
+    return *this;
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  /* Chunks are looked up in bulk into the front array first, and only
+   * positives are then looked up in bulk into the main array.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    std::uint64_t hashes[bulk_may_contain_size];
+    bool          results[bulk_may_contain_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(auto it=first;n<bulk_may_contain_size&&it!=last;++it){
+        hashes[n++]=promoting_hash_for(*it);
+      }
+
+      const std::uint64_t* p=hashes;
+      bool*                pr=results;
+      std::size_t          m=0;
+      front.bulk_may_contain(
+        [&p]{return front_hash(*p++);},n,
+        [&](bool res){
+          *pr++=res;
+          m+=res;
+        });
+
+      std::size_t i=0;
+      auto        next_positive=[&]{
+        while(!results[i])++i;
+        return i++;
+      };
+      pr=results;
+      main.bulk_may_contain(
+        [&]{return hashes[next_positive()];},m,
+        [&](bool res){
+          while(!*pr)++pr;
+          *pr++=res;
+        });
+
+      for(std::size_t j=0;j<n;++j)f(*first++,results[j]);
+    }
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  const Hash& h()const{return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const T& x)const
+  {
+    return hash_for(x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const U& x)const
+  {
+    return hash_for(x);
+  }
+
+  static std::size_t default_front_capacity(std::size_t m)noexcept
+  {
+    return (std::min)(m/front_capacity_ratio,front_cache_size*CHAR_BIT);
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline std::uint64_t front_hash(std::uint64_t hash)noexcept
+  {
+    return detail::mulx64(hash);
+  }
+
+  /* Zero-capacity arrays are skipped altogether rather than relying on
+   * filter_core's null check, which comes after write-prefetching into its
+   * dummy array.
+   */
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    if(!capacity())return;
+    main.insert(hash);
+    if(front_capacity())front.insert(front_hash(hash));
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    return front.may_contain(front_hash(hash))&&main.may_contain(hash);
+  }
+
+  void check_compatible(const cascaded_filter& x)const
+  {
+    /* front arrays are checked before any of the two arrays is modified */
+
+    if(front.capacity()!=x.front.capacity()){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
+    }
+  }
+
+  core_type       main;
+  front_core_type front;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,350 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_COUNT_MIN_SKETCH_HPP
+#define BOOST_BLOOM_COUNT_MIN_SKETCH_HPP
+
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/count_min_block.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/throw_exception.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Count-min sketch (Cormode and Muthukrishnan, 2005) with conservative
+ * update (Estan and Varghese, 2002). The array of counters is handled by a
+ * filter_core with K=1 whose subfilter, count_min_block, holds the Depth
+ * counters of each element within a single cache line, so that updates and
+ * estimations take one memory access and benefit from filter_core's
+ * positioning and bulk insertion pipeline. Counters are optionally halved
+ * every given number of insertions to age out old frequencies.
+ */
+
+template<
+  typename T,std::size_t Depth=4,typename Counter=std::uint32_t,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class count_min_sketch:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using block_type=detail::count_min_block<Counter,Depth>;
+  using core_type=detail::filter_core<1,block_type,0,Allocator>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t depth=Depth;
+  using counter_type=Counter;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=core_type::bulk_insert_size;
+  static constexpr std::size_t bulk_estimate_size=
+    core_type::bulk_may_contain_size;
+
+  explicit count_min_sketch(
+    std::size_t m=0,std::size_t period=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},core{m,al},halving_period_{period}{}
+
+  count_min_sketch(std::size_t m,const allocator_type& al):
+    count_min_sketch{m,0,hasher(),al}{}
+
+  count_min_sketch(
+    std::size_t m,std::size_t period,const allocator_type& al):
+    count_min_sketch{m,period,hasher(),al}{}
+
+  template<typename InputIterator>
+  count_min_sketch(
+    InputIterator first,InputIterator last,
+    std::size_t m,std::size_t period=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    count_min_sketch{m,period,h,al}
+  {
+    insert(first,last);
+  }
+
+  count_min_sketch(
+    std::initializer_list<value_type> il,
+    std::size_t m,std::size_t period=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    count_min_sketch{il.begin(),il.end(),m,period,h,al}{}
+
+  count_min_sketch(const count_min_sketch&)=default;
+  count_min_sketch(count_min_sketch&&)=default;
+  count_min_sketch& operator=(const count_min_sketch&)=default;
+  count_min_sketch& operator=(count_min_sketch&&)=default;
+
+  allocator_type get_allocator()const noexcept
+  {
+    return core.get_allocator();
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return core.capacity();
+  }
+
+  std::size_t counter_count()const noexcept
+  {
+    return core.capacity()/(sizeof(Counter)*CHAR_BIT);
+  }
+
+  std::size_t halving_period()const noexcept
+  {
+    return halving_period_;
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    core.insert(hash_for(x));
+    count_insertions(1);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    core.insert(hash_for(x));
+    count_insertions(1);
+  }
+
+  /* Hashes are buffered and fed to filter_core::bulk_insert, with buffers
+   * cut short at halving points.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    std::uint64_t hashes[insert_buffer_size];
+    while(first!=last){
+      std::size_t n=0,
+                  max_n=insert_buffer_size;
+      if(halving_period_&&halving_period_-insertions<max_n){
+        max_n=halving_period_-insertions;
+      }
+      for(;n<max_n&&first!=last;++first,++n)hashes[n]=hash_for(*first);
+      const std::uint64_t* p=hashes;
+      core.bulk_insert([&p]{return *p++;},n);
+      count_insertions(n);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  /* Divides all counters by two, rounding down. This and operator+= loop
+   * over whole blocks so that the inner loops are unrolled and vectorized.
+   */
+
+  void halve()noexcept
+  {
+    auto p=counters();
+    for(auto last=p+counter_count();p!=last;p+=num_counters){
+      for(std::size_t i=0;i<num_counters;++i)p[i]>>=1;
+    }
+    insertions=0;
+  }
+
+  /* Counter-wise saturated addition. Estimations of the result are not less
+   * than the sum of the estimations of *this and x.
+   */
+
+  count_min_sketch& operator+=(const count_min_sketch& x)
+  {
+    if(capacity()!=x.capacity()){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible sketches"));
+    }
+    auto p=counters();
+    auto q=x.counters();
+    for(auto last=p+counter_count();p!=last;p+=num_counters,q+=num_counters){
+      Counter y[num_counters]; /* avoids aliasing checks */
+      std::memcpy(y,q,sizeof(y));
+      for(std::size_t i=0;i<num_counters;++i){
+        Counter s=(Counter)(p[i]+y[i]);
+        p[i]=(Counter)(s|(Counter)(0-(Counter)(s<p[i])));
+      }
+    }
+    return *this;
+  }
+
+  void swap(count_min_sketch& x)
+    noexcept(noexcept(std::declval<core_type&>().swap(
+      std::declval<core_type&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    core.swap(x.core);
+    swap(h(),x.h());
+    swap(halving_period_,x.halving_period_);
+    swap(insertions,x.insertions);
+  }
+
+  void clear()noexcept
+  {
+    core.clear();
+    insertions=0;
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  /* an upper bound of the number of times x has been inserted */
+
+  BOOST_FORCEINLINE size_type estimate(const T& x)const
+  {
+    return estimate_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE size_type estimate(const U& x)const
+  {
+    return estimate_hash(hash_for(x));
+  }
+
+  /* Cache lines of a chunk of elements are prefetched before any of them
+   * is estimated.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void estimate(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    if(!capacity()){
+      for(;first!=last;++first)f(*first,(size_type)max_counter);
+      return;
+    }
+
+    std::uint64_t        hashes[bulk_estimate_size];
+    const unsigned char* positions[bulk_estimate_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(auto it=first;n<bulk_estimate_size&&it!=last;++it,++n){
+        auto& hash=hashes[n]=hash_for(*it);
+        positions[n]=core.start_may_contain(hash);
+      }
+      for(std::size_t i=0;i<n;++i,++first){
+        f(*first,(size_type)block_type::estimate(
+          *reinterpret_cast<const block_value_type*>(positions[i]),
+          hashes[i]));
+      }
+    }
+  }
+
+private:
+  template<typename T1,std::size_t D1,typename C1,typename H1,typename A1>
+  bool friend operator==(
+    const count_min_sketch<T1,D1,C1,H1,A1>& x,
+    const count_min_sketch<T1,D1,C1,H1,A1>& y);
+
+  using hash_base=empty_value<Hash,0>;
+  using block_value_type=typename block_type::value_type;
+  static constexpr Counter     max_counter=block_type::max_counter;
+  static constexpr std::size_t num_counters=block_type::num_counters;
+  static constexpr std::size_t insert_buffer_size=4*bulk_insert_size;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE size_type estimate_hash(std::uint64_t hash)const
+  {
+    if(!capacity())return (size_type)max_counter;
+    auto p=core.start_may_contain(hash);
+    return (size_type)block_type::estimate(
+      *reinterpret_cast<const block_value_type*>(p),hash);
+  }
+
+  BOOST_FORCEINLINE void count_insertions(std::size_t n)
+  {
+    insertions+=n;
+    if(halving_period_&&insertions>=halving_period_)halve();
+  }
+
+  Counter* counters()noexcept
+  {
+    return reinterpret_cast<Counter*>(core.array().data());
+  }
+
+  const Counter* counters()const noexcept
+  {
+    return reinterpret_cast<const Counter*>(core.array().data());
+  }
+
+  core_type   core;
+  std::size_t halving_period_;
+  std::size_t insertions=0;
+};
+
+template<typename T,std::size_t D,typename C,typename H,typename A>
+bool operator==(
+  const count_min_sketch<T,D,C,H,A>& x,const count_min_sketch<T,D,C,H,A>& y)
+{
+  return x.core==y.core;
+}
+
+template<typename T,std::size_t D,typename C,typename H,typename A>
+bool operator!=(
+  const count_min_sketch<T,D,C,H,A>& x,const count_min_sketch<T,D,C,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,std::size_t D,typename C,typename H,typename A>
+void swap(count_min_sketch<T,D,C,H,A>& x,count_min_sketch<T,D,C,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
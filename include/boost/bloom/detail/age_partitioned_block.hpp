@@ -0,0 +1,248 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_AGE_PARTITIONED_BLOCK_HPP
+#define BOOST_BLOOM_DETAIL_AGE_PARTITIONED_BLOCK_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Block for age_partitioned_filter: one 64-bit word per slice, so that the
+ * K+L slices of an element are adjacent in memory. Physical slice j uses
+ * the (j%8)-th 6-bit chunk of the hash, rehashed with mulx64 every 8
+ * slices, as its bit position; this way, groups of 4 or 8 slices draw from
+ * the same hash value and can be processed with SIMD. Slices are addressed
+ * logically from youngest (0) to oldest (K+L-1), logical slice i being
+ * physical slice (base+i)%(K+L), so that aging all slices only takes
+ * changing base.
+ */
+
+template<std::size_t K,std::size_t L>
+struct age_partitioned_block
+{
+  static_assert(K>0,"K must be greater than zero");
+  static_assert(K+L<=64,"K+L must not exceed 64");
+  static constexpr std::size_t k=K;
+  static constexpr std::size_t num_slices=K+L;
+  using value_type=std::uint64_t[num_slices];
+
+  /* sets the bit of the element in the K youngest slices */
+
+  static BOOST_FORCEINLINE void mark(
+    value_type& x,std::uint64_t hash,std::size_t base)
+  {
+    set_bits(x,hash,rotate_left(ones(K),base));
+  }
+
+  /* checks whether the bit of the element is set in K consecutive slices */
+
+  static BOOST_FORCEINLINE bool check(
+    const value_type& x,std::uint64_t hash,std::size_t base)
+  {
+    std::uint64_t hits=rotate_right(get_bits(x,hash),base);
+
+    /* after each step, bit i of hits is set iff bits [i,i+len) were */
+
+    for(std::size_t len=1;len<K;){
+      std::size_t s=len<K-len?len:K-len;
+      hits&=hits>>s;
+      len+=s;
+    }
+    return hits!=0;
+  }
+
+private:
+  static constexpr std::size_t shift=6;
+  static constexpr std::size_t rehash_n=8;
+
+  static BOOST_FORCEINLINE std::uint64_t ones(std::size_t n)
+  {
+    return n>=64?~std::uint64_t(0):(std::uint64_t(1)<<n)-1;
+  }
+
+  /* rotations within the num_slices least significant bits */
+
+  static BOOST_FORCEINLINE std::uint64_t rotate_left(
+    std::uint64_t x,std::size_t n)
+  {
+    return n?((x<<n)|(x>>(num_slices-n)))&ones(num_slices):x;
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t rotate_right(
+    std::uint64_t x,std::size_t n)
+  {
+    return n?((x>>n)|(x<<(num_slices-n)))&ones(num_slices):x;
+  }
+
+  /* set_bits sets the bit of the element in the physical slices indicated
+   * by mask, get_bits returns the mask of physical slices where the bit of
+   * the element is set.
+   */
+
+#if defined(BOOST_BLOOM_AVX512)
+  static BOOST_FORCEINLINE __m512i positions(std::uint64_t hash)
+  {
+    const __m512i shifts=_mm512_setr_epi64(6,12,18,24,30,36,42,48);
+
+    return _mm512_and_si512(
+      mm512_srlv_epi64(_mm512_set1_epi64((long long)hash),shifts),
+      _mm512_set1_epi64(63));
+  }
+
+  static BOOST_FORCEINLINE void set_bits(
+    value_type& x,std::uint64_t hash,std::uint64_t mask)
+  {
+    const __m512i one=_mm512_set1_epi64(1);
+
+    for(std::size_t j=0;j<num_slices;j+=8){
+      const __mmask8 m=(__mmask8)(mask>>j);
+      if(m){
+        __m512i bits=mm512_sllv_epi64(one,positions(hash));
+        _mm512_mask_storeu_epi64(
+          x+j,m,_mm512_or_si512(_mm512_maskz_loadu_epi64(m,x+j),bits));
+      }
+      hash=detail::mulx64(hash);
+    }
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t get_bits(
+    const value_type& x,std::uint64_t hash)
+  {
+    const __m512i one=_mm512_set1_epi64(1);
+
+    std::uint64_t res=0;
+    for(std::size_t j=0;j<num_slices;j+=8){
+      const __mmask8 m=(__mmask8)ones(num_slices-j);
+      __m512i        v=mm512_srlv_epi64(
+        _mm512_maskz_loadu_epi64(m,x+j),positions(hash));
+      res|=(std::uint64_t)_mm512_test_epi64_mask(v,one)<<j;
+      hash=detail::mulx64(hash);
+    }
+    return res;
+  }
+#elif defined(BOOST_BLOOM_AVX2)
+  static BOOST_FORCEINLINE __m256i positions(std::uint64_t hash,std::size_t j)
+  {
+    const __m256i lo=_mm256_setr_epi64x(6,12,18,24),
+                  hi=_mm256_setr_epi64x(30,36,42,48);
+
+    return _mm256_and_si256(
+      _mm256_srlv_epi64(_mm256_set1_epi64x((long long)hash),j&4?hi:lo),
+      _mm256_set1_epi64x(63));
+  }
+
+  static BOOST_FORCEINLINE __m256i lane_mask(std::uint64_t mask)
+  {
+    const __m256i lanes=_mm256_setr_epi64x(0,1,2,3);
+
+    return _mm256_sub_epi64(
+      _mm256_setzero_si256(),
+      _mm256_and_si256(
+        _mm256_srlv_epi64(_mm256_set1_epi64x((long long)mask),lanes),
+        _mm256_set1_epi64x(1)));
+  }
+
+  static BOOST_FORCEINLINE void set_bits(
+    value_type& x,std::uint64_t hash,std::uint64_t mask)
+  {
+    const __m256i one=_mm256_set1_epi64x(1);
+
+    for(std::size_t j=0;j<num_slices;j+=4){
+      const __m256i m=lane_mask(mask>>j);
+      __m256i       bits=_mm256_and_si256(
+        _mm256_sllv_epi64(one,positions(hash,j)),m);
+      auto          p=reinterpret_cast<long long*>(x+j);
+      if(num_slices-j>=4){
+        _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(p),
+          _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)),bits));
+      }
+      else{
+        _mm256_maskstore_epi64(
+          p,m,_mm256_or_si256(_mm256_maskload_epi64(p,m),bits));
+      }
+      if(j&4)hash=detail::mulx64(hash);
+    }
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t get_bits(
+    const value_type& x,std::uint64_t hash)
+  {
+    std::uint64_t res=0;
+    for(std::size_t j=0;j<num_slices;j+=4){
+      auto    p=reinterpret_cast<const long long*>(x+j);
+      __m256i v;
+      if(num_slices-j>=4){
+        v=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      }
+      else{
+        v=_mm256_maskload_epi64(p,lane_mask(ones(num_slices-j)));
+      }
+      v=_mm256_srlv_epi64(v,positions(hash,j));
+      res|=(std::uint64_t)_mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_slli_epi64(v,63)))<<j;
+      if(j&4)hash=detail::mulx64(hash);
+    }
+    return res;
+  }
+#else
+  static BOOST_FORCEINLINE void set_bits(
+    value_type& x,std::uint64_t hash,std::uint64_t mask)
+  {
+    loop(hash,[&](std::size_t j,std::uint64_t pos){
+      x[j]|=((mask>>j)&1)<<pos;
+    });
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t get_bits(
+    const value_type& x,std::uint64_t hash)
+  {
+    std::uint64_t res=0;
+    loop(hash,[&](std::size_t j,std::uint64_t pos){
+      res|=((x[j]>>pos)&1)<<j;
+    });
+    return res;
+  }
+
+  template<typename F>
+  static BOOST_FORCEINLINE void loop(std::uint64_t hash,F f)
+  {
+    for(std::size_t j=0;j<num_slices;){
+      auto h=hash;
+      for(std::size_t r=0;r<rehash_n&&j<num_slices;++r,++j){
+        h>>=shift;
+        f(j,h&63);
+      }
+      hash=detail::mulx64(hash);
+    }
+  }
+#endif
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
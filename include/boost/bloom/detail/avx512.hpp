@@ -0,0 +1,58 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_AVX512_HPP
+
+#if defined(__AVX512F__)
+#define BOOST_BLOOM_AVX512
+#endif
+
+#if defined(BOOST_BLOOM_AVX512)
+#include <boost/config.hpp>
+#include <immintrin.h>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Unmasked forms of some AVX-512 intrinsics, implemented with their
+ * zero-masking counterparts and an all-ones mask. In GCC 12, the unmasked
+ * intrinsics pass an _mm512_undefined_epi32() vector to the underlying
+ * masked builtins, which triggers spurious -Wmaybe-uninitialized warnings
+ * once inlined into user code.
+ */
+
+BOOST_FORCEINLINE __m512i mm512_srli_epi64(__m512i x,unsigned int n)
+{
+  return _mm512_maskz_srli_epi64((__mmask8)0xFF,x,n);
+}
+
+BOOST_FORCEINLINE __m512i mm512_srlv_epi64(__m512i x,__m512i n)
+{
+  return _mm512_maskz_srlv_epi64((__mmask8)0xFF,x,n);
+}
+
+BOOST_FORCEINLINE __m512i mm512_sllv_epi64(__m512i x,__m512i n)
+{
+  return _mm512_maskz_sllv_epi64((__mmask8)0xFF,x,n);
+}
+
+/* ~x&y */
+
+BOOST_FORCEINLINE __m512i mm512_andnot_si512(__m512i x,__m512i y)
+{
+  return _mm512_maskz_andnot_epi64((__mmask8)0xFF,x,y);
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_BIT_ROWS_HPP
+#define BOOST_BLOOM_DETAIL_BIT_ROWS_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/sse2.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Bit rows are arrays of 64-bit words processed in chunks of
+ * bit_rows_chunk_words words (one cacheline). and_rows ANDs the chunks at
+ * offset off of rows[0],...,rows[n-1] (n>0) into res, stopping as soon as
+ * the partial result is zero, and returns whether res is not zero.
+ */
+
+constexpr std::size_t bit_rows_chunk_words=8;
+
+#if defined(BOOST_BLOOM_AVX512)
+BOOST_FORCEINLINE bool and_rows(
+  const std::uint64_t* const* rows,std::size_t n,std::size_t off,
+  std::uint64_t* res)
+{
+  __m512i acc=_mm512_loadu_si512(rows[0]+off);
+  for(std::size_t i=1;i<n;++i){
+    if(!_mm512_test_epi64_mask(acc,acc))break;
+    acc=_mm512_and_si512(acc,_mm512_loadu_si512(rows[i]+off));
+  }
+  _mm512_storeu_si512(res,acc);
+  return _mm512_test_epi64_mask(acc,acc)!=0;
+}
+#elif defined(BOOST_BLOOM_AVX2)
+BOOST_FORCEINLINE bool and_rows(
+  const std::uint64_t* const* rows,std::size_t n,std::size_t off,
+  std::uint64_t* res)
+{
+  auto load=[&](std::size_t i,std::size_t j){
+    return _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(rows[i]+off+j));
+  };
+  auto nonzero=[](__m256i x,__m256i y){
+    __m256i z=_mm256_or_si256(x,y);
+    return !_mm256_testz_si256(z,z);
+  };
+
+  __m256i acc0=load(0,0),acc1=load(0,4);
+  for(std::size_t i=1;i<n;++i){
+    if(!nonzero(acc0,acc1))break;
+    acc0=_mm256_and_si256(acc0,load(i,0));
+    acc1=_mm256_and_si256(acc1,load(i,4));
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(res),acc0);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(res+4),acc1);
+  return nonzero(acc0,acc1);
+}
+#elif defined(BOOST_BLOOM_SSE2)
+BOOST_FORCEINLINE bool and_rows(
+  const std::uint64_t* const* rows,std::size_t n,std::size_t off,
+  std::uint64_t* res)
+{
+  auto load=[&](std::size_t i,std::size_t j){
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i]+off+j));
+  };
+  auto nonzero=[](__m128i x0,__m128i x1,__m128i x2,__m128i x3){
+    __m128i z=_mm_or_si128(_mm_or_si128(x0,x1),_mm_or_si128(x2,x3));
+    return
+      _mm_movemask_epi8(_mm_cmpeq_epi8(z,_mm_setzero_si128()))!=0xFFFF;
+  };
+
+  __m128i acc0=load(0,0),acc1=load(0,2),acc2=load(0,4),acc3=load(0,6);
+  for(std::size_t i=1;i<n;++i){
+    if(!nonzero(acc0,acc1,acc2,acc3))break;
+    acc0=_mm_and_si128(acc0,load(i,0));
+    acc1=_mm_and_si128(acc1,load(i,2));
+    acc2=_mm_and_si128(acc2,load(i,4));
+    acc3=_mm_and_si128(acc3,load(i,6));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(res),acc0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(res+2),acc1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(res+4),acc2);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(res+6),acc3);
+  return nonzero(acc0,acc1,acc2,acc3);
+}
+#else
+BOOST_FORCEINLINE bool and_rows(
+  const std::uint64_t* const* rows,std::size_t n,std::size_t off,
+  std::uint64_t* res)
+{
+  std::uint64_t any=0;
+  for(std::size_t j=0;j<bit_rows_chunk_words;++j){
+    any|=res[j]=rows[0][off+j];
+  }
+  for(std::size_t i=1;i<n&&any;++i){
+    any=0;
+    for(std::size_t j=0;j<bit_rows_chunk_words;++j){
+      any|=res[j]&=rows[i][off+j];
+    }
+  }
+  return any!=0;
+}
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,114 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_BLOCK_VERTICAL_CHECK_HPP
+#define BOOST_BLOOM_DETAIL_BLOCK_VERTICAL_CHECK_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/block_base.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Optional support for checking several elements at once ("vertically",
+ * i.e. across keys rather than within a block) in bulk lookups. When
+ * available, block<Block,K> provides
+ *
+ *   static constexpr std::size_t vertical_check_size;
+ *   static int vertical_check(
+ *     const unsigned char* base,
+ *     const std::uint64_t* offsets,const std::uint64_t* hashes);
+ *
+ * where vertical_check returns a mask whose i-th bit is the result of
+ * checking hashes[i] against the block at base+offsets[i], for i in
+ * [0,vertical_check_size). Supported for std::uint64_t blocks with K bits
+ * obtained from a single hash value (no rehashing).
+ */
+
+template<typename Block,std::size_t K,typename=void>
+struct block_vertical_check{};
+
+#if defined(BOOST_BLOOM_AVX512)||defined(BOOST_BLOOM_AVX2)
+template<std::size_t K>
+struct block_vertical_check<
+  std::uint64_t,K,
+  typename std::enable_if<
+    (K<=block_base<std::uint64_t,K>::rehash_k)>::type
+>
+{
+#if defined(BOOST_BLOOM_AVX512)
+  static constexpr std::size_t vertical_check_size=8;
+
+  static BOOST_FORCEINLINE int vertical_check(
+    const unsigned char* base,
+    const std::uint64_t* offsets,const std::uint64_t* hashes)
+  {
+    const __m512i zero=_mm512_setzero_si512(),
+                  ones=_mm512_set1_epi64(1),
+                  mask=_mm512_set1_epi64(63);
+
+    __m512i h=_mm512_loadu_si512(hashes),
+            fp=zero;
+    for(std::size_t i=0;i<K;++i){
+      h=mm512_srli_epi64(h,shift);
+      fp=_mm512_or_si512(
+        fp,mm512_sllv_epi64(ones,_mm512_and_si512(h,mask)));
+    }
+    __m512i x=_mm512_mask_i64gather_epi64(
+      zero,(__mmask8)0xFF,_mm512_loadu_si512(offsets),base,1);
+    return (int)_mm512_cmpeq_epi64_mask(_mm512_and_si512(x,fp),fp);
+  }
+#else /* AVX2 */
+  static constexpr std::size_t vertical_check_size=4;
+
+  static BOOST_FORCEINLINE int vertical_check(
+    const unsigned char* base,
+    const std::uint64_t* offsets,const std::uint64_t* hashes)
+  {
+    const __m256i ones=_mm256_set1_epi64x(1),
+                  mask=_mm256_set1_epi64x(63);
+
+    __m256i h=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes)),
+            fp=_mm256_setzero_si256();
+    for(std::size_t i=0;i<K;++i){
+      h=_mm256_srli_epi64(h,shift);
+      fp=_mm256_or_si256(
+        fp,_mm256_sllv_epi64(ones,_mm256_and_si256(h,mask)));
+    }
+    __m256i x=_mm256_i64gather_epi64(
+      reinterpret_cast<const long long*>(base),
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)),1);
+    return _mm256_movemask_pd(
+      _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(x,fp),fp)));
+  }
+#endif
+
+private:
+  static constexpr int shift=(int)block_base<std::uint64_t,K>::shift;
+};
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -77,6 +77,33 @@ _mm_prefetch((const char*)(p),_MM_HINT_T0)
 #define BOOST_BLOOM_PREFETCH_WRITE(p) ((void)(p))
 #endif
 
+/* Cache line size assumed for prefetching and array alignment, and number
+ * of cache lines prefetched in advance by bulk operations and
+ * lookup_pipeline. Overridable by the user to tune performance to the
+ * target architecture.
+ */
+
+#if !defined(BOOST_BLOOM_CACHELINE_SIZE)
+#define BOOST_BLOOM_CACHELINE_SIZE 64
+#endif
+
+#if !defined(BOOST_BLOOM_BULK_PREFETCH_CACHELINES)
+#define BOOST_BLOOM_BULK_PREFETCH_CACHELINES 64
+#endif
+
+#if !defined(BOOST_BLOOM_PIPELINE_PREFETCH_CACHELINES)
+#define BOOST_BLOOM_PIPELINE_PREFETCH_CACHELINES 16
+#endif
+
+/* Percentage of successful lookups in a bulk_may_contain chunk from which
+ * the next chunk is checked without skipping already discarded elements
+ * (see bulk_may_contain_rounds). 0 means always, values over 100 never.
+ */
+
+#if !defined(BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD)
+#define BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD 70
+#endif
+
 namespace boost{
 namespace bloom{
 namespace detail{
@@ -149,6 +176,26 @@ struct used_value_size<
   static constexpr std::size_t value=Subfilter::used_value_size;
 };
 
+/* vertical_check_size<Subfilter>::value is Subfilter::vertical_check_size
+ * if it exists, or 0 otherwise. Subfilters with nonzero vertical_check_size
+ * can check that many elements at once (see block_vertical_check.hpp).
+ */
+
+template<typename Subfilter,typename=void>
+struct vertical_check_size
+{
+  static constexpr std::size_t value=0;
+};
+
+template<typename Subfilter>
+struct vertical_check_size<
+  Subfilter,
+  typename std::enable_if<Subfilter::vertical_check_size!=0>::type
+>
+{
+  static constexpr std::size_t value=Subfilter::vertical_check_size;
+};
+
 /* GCD with x,p > 1, p a power of two */
 
 constexpr std::size_t gcd_pow2(std::size_t x,std::size_t p)
@@ -184,6 +231,26 @@ struct filter_array
   unsigned char* array; /* adjusted from data for proper alignment */
 };
 
+/* Uninitialized buffer of trivial objects allocated through Allocator. */
+
+template<typename T,typename Allocator>
+class temporary_buffer
+{
+public:
+  temporary_buffer(const Allocator& al_,std::size_t n_):
+    al{al_},n{n_},p{allocator_allocate(al,n)}{}
+  temporary_buffer(const temporary_buffer&)=delete;
+  temporary_buffer& operator=(const temporary_buffer&)=delete;
+  ~temporary_buffer(){allocator_deallocate(al,p,n);}
+
+  T* data()const noexcept{return p;}
+
+private:
+  allocator_rebind_t<Allocator,T> al;
+  std::size_t                     n;
+  T*                              p;
+};
+
 struct if_constexpr_void_else{void operator()()const{}};
 
 template<bool B,typename F,typename G=if_constexpr_void_else>
@@ -241,7 +308,19 @@ private:
   static constexpr std::size_t tail_size=sizeof(block_type)-stride;
   static constexpr bool are_blocks_aligned=
     (stride%alignof(block_type)==0);
-  static constexpr std::size_t cacheline=64; /* unknown at compile time */
+  static constexpr std::size_t cacheline=BOOST_BLOOM_CACHELINE_SIZE;
+  static_assert(
+    cacheline>0&&(cacheline&(cacheline-1))==0,
+    "BOOST_BLOOM_CACHELINE_SIZE must be a power of two");
+  static constexpr std::size_t bulk_prefetch_budget=
+    BOOST_BLOOM_BULK_PREFETCH_CACHELINES;
+  static constexpr std::size_t pipeline_prefetch_budget=
+    BOOST_BLOOM_PIPELINE_PREFETCH_CACHELINES;
+  static_assert(
+    bulk_prefetch_budget>0&&pipeline_prefetch_budget>0,
+    "prefetch budgets must be greater than zero");
+  static constexpr std::size_t branchless_lookup_threshold=
+    BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD;
   static constexpr std::size_t initial_alignment=
     are_blocks_aligned?
       alignof(block_type)>cacheline?alignof(block_type):cacheline:
@@ -257,12 +336,34 @@ public:
   using pointer=unsigned char*;
   using const_pointer=const unsigned char*;
   static constexpr std::size_t bulk_insert_size=
-    (64+prefetched_cachelines-1)/prefetched_cachelines;
+    (bulk_prefetch_budget+prefetched_cachelines-1)/prefetched_cachelines;
   static constexpr std::size_t bulk_may_contain_size=
-    (64+prefetched_cachelines-1)/prefetched_cachelines;
+    bulk_insert_size<64?bulk_insert_size:64;
   static_assert(
     bulk_may_contain_size<=64, /* see results in bulk_may_contain */
     "internal check, bulk_may_contain_size must be <= 64");
+  static constexpr std::size_t pipelined_may_contain_size=
+    (pipeline_prefetch_budget+prefetched_cachelines-1)/prefetched_cachelines;
+
+private:
+  static constexpr std::size_t vertical_check_size=
+    detail::vertical_check_size<subfilter>::value;
+  static constexpr bool use_vertical_check=
+    k==1&&vertical_check_size!=0&&
+    bulk_may_contain_size%vertical_check_size==0;
+
+  struct partition_entry
+  {
+    std::size_t   pos;
+    std::uint64_t hash;
+  };
+
+  static constexpr std::size_t partition_size=1024*1024;
+  static constexpr std::size_t max_partitions=32;
+  static constexpr std::size_t partition_batch_size=1<<22;
+  static constexpr std::size_t partition_prefetch_distance=32;
+
+public:
 
   explicit filter_core(std::size_t m=0):filter_core{m,allocator_type{}}{}
 
@@ -432,6 +533,18 @@ public:
     }
   }
 
+  /* Counterpart of start_may_contain for subfilters whose marking depends on
+   * more than the hash (see stable_filter): prepares hash and returns the
+   * first position, prefetched for writing. Unlike insert, no null check is
+   * done, so the caller must make sure capacity()!=0.
+   */
+
+  BOOST_FORCEINLINE unsigned char* start_insert(std::uint64_t& hash)
+  {
+    hs.prepare_hash(hash);
+    return next_element(hash);
+  }
+
   template<typename HashStream>
   void bulk_insert(HashStream h,std::size_t n)
   {
@@ -489,6 +602,70 @@ public:
     while(n--)insert(h());
   }
 
+  /* partitioned_bulk_insert is meant for arrays much larger than the
+   * last-level cache. Elements are hashed in batches and their k positions
+   * are radix-partitioned by their high bits into at most max_partitions
+   * buckets of at least partition_size bytes each, which are then marked
+   * bucket by bucket (with software prefetching) so that writes are confined
+   * to a narrow region of the array, reducing TLB misses and DRAM page
+   * switches. Partitioning is a counting sort: prepared hashes are stored in
+   * a first pass that counts bucket sizes, and positions are recalculated in
+   * the scatter pass, which is cheaper than storing them twice. Fanout is
+   * kept low as scattering into many buckets is itself TLB-bound.
+   */
+
+  template<typename HashStream>
+  void partitioned_bulk_insert(HashStream h,std::size_t n)
+  {
+    if(range()*stride<=2*partition_size){
+      bulk_insert(h,n);
+      return;
+    }
+
+    std::size_t shift=0;
+    while((stride<<shift)<partition_size)++shift;
+    while(((range()-1)>>shift)>=max_partitions)++shift;
+    const std::size_t num_buckets=((range()-1)>>shift)+1,
+                      batch=n<partition_batch_size?n:partition_batch_size;
+
+    temporary_buffer<std::uint64_t,allocator_type>   hashes{al(),batch};
+    temporary_buffer<std::size_t,allocator_type>     offsets{
+                                                       al(),num_buckets+1};
+    temporary_buffer<partition_entry,allocator_type> entries{al(),batch*k};
+
+    while(n){
+      const std::size_t m=n<batch?n:batch;
+      auto              offs=offsets.data();
+      std::fill(offs,offs+num_buckets+1,std::size_t(0));
+      for(std::size_t i=0;i<m;++i){
+        auto hash=h();
+        hs.prepare_hash(hash);
+        hashes.data()[i]=hash;
+        for(auto j=k;j--;)++offs[(hs.next_position(hash)>>shift)+1];
+      }
+      for(std::size_t i=1;i<num_buckets;++i)offs[i]+=offs[i-1];
+      for(std::size_t i=0;i<m;++i){
+        auto hash=hashes.data()[i];
+        for(auto j=k;j--;){
+          auto pos=hs.next_position(hash);
+          entries.data()[offs[pos>>shift]++]={pos,hash};
+        }
+      }
+      auto first=entries.data(),last=first+m*k;
+      if(m*k>partition_prefetch_distance){
+        for(auto it=first;it!=first+partition_prefetch_distance;++it){
+          prefetch_element(it->pos);
+        }
+        for(;first!=last-partition_prefetch_distance;++first){
+          prefetch_element(first[partition_prefetch_distance].pos);
+          set(ar.array+first->pos*stride,first->hash);
+        }
+      }
+      for(;first!=last;++first)set(ar.array+first->pos*stride,first->hash);
+      n-=m;
+    }
+  }
+
   void swap(filter_core& x)noexcept(
     allocator_propagate_on_container_swap_t<allocator_type>::value||
     allocator_is_always_equal_t<allocator_type>::value)
@@ -564,10 +741,36 @@ public:
 #endif
   }
 
+  /* may_contain split in two phases so that lookups can be pipelined by
+   * the caller: start_may_contain prepares hash and prefetches the first
+   * position, which is then passed to finish_may_contain.
+   */
+
+  BOOST_FORCEINLINE
+  const unsigned char* start_may_contain(std::uint64_t& hash)const
+  {
+    hs.prepare_hash(hash);
+    return next_element(hash);
+  }
+
+  BOOST_FORCEINLINE bool finish_may_contain(
+    const unsigned char* p,std::uint64_t hash)const
+  {
+    for(auto n=k;;){
+      if(!get(p,hash))return false;
+      if(!--n)return true;
+      p=next_element(hash);
+    }
+  }
+
   template<typename HashStream,typename F>
   void bulk_may_contain(HashStream h,std::size_t n,F f)const
   {
-    if(k==1){
+    if(use_vertical_check){
+      vertical_bulk_may_contain(
+        h,n,f,std::integral_constant<bool,use_vertical_check>{});
+    }
+    else if(k==1){
       std::uint64_t        hashes[bulk_may_contain_size];
       const unsigned char* positions[bulk_may_contain_size];
 
@@ -610,6 +813,7 @@ public:
       std::uint64_t        hashes[bulk_may_contain_size];
       const unsigned char* positions[bulk_may_contain_size];
       std::uint64_t        results=initial_result_mask;
+      bool                 branchless=(branchless_lookup_threshold==0);
 
       if(n>=2*bulk_may_contain_size){
         for(std::size_t i=0;i<bulk_may_contain_size;++i){
@@ -619,19 +823,8 @@ public:
           p=next_element(hash);
         }
         do{
-          for(auto j=k;j--;){
-            auto mask=results;
-            if(!mask)break;
-            do{
-              auto i=unchecked_countr_zero(mask);
-              auto& hash=hashes[i];
-              auto& p=positions[i];
-              auto  b=get(p,hash);
-              p=next_element(hash);
-              results&=~(std::uint64_t(!b)<<i);
-              mask&=mask-1;
-            }while(mask);
-          }
+          bulk_may_contain_rounds(hashes,positions,results,branchless);
+          branchless=use_branchless_rounds(results);
           for(std::size_t i=0;i<bulk_may_contain_size;++i){
             auto& hash=hashes[i];
             auto& p=positions[i];
@@ -645,19 +838,7 @@ public:
           n-=bulk_may_contain_size;
         }while(n>=2*bulk_may_contain_size);
 
-        for(auto j=k;j--;){
-          auto mask=results;
-          if(!mask)break;
-          do{
-            auto i=unchecked_countr_zero(mask);
-            auto& hash=hashes[i];
-            auto& p=positions[i];
-            auto  b=get(p,hash);
-            p=next_element(hash);
-            results&=~(std::uint64_t(!b)<<i);
-            mask&=mask-1;
-          }while(mask);
-        }
+        bulk_may_contain_rounds(hashes,positions,results,branchless);
         for(std::size_t i=0;i<bulk_may_contain_size;++i){
           f(results&1);
           results>>=1;
@@ -669,6 +850,65 @@ public:
     }
   }
 
+  /* bulk_multi_may_contain is a variation of bulk_may_contain where each
+   * lookup may be done on a different filter: FilterHashStream s is invoked
+   * as s(hash), returns a reference to the filter to look into and sets hash
+   * to the (unprepared) hash value to look for.
+   */
+
+  template<typename FilterHashStream,typename F>
+  static void bulk_multi_may_contain(FilterHashStream s,std::size_t n,F f)
+  {
+    if(k==1){
+      /* Lookups consist of one memory access with no dependencies between
+       * them, and out-of-order execution alone does a better job at hiding
+       * latency than explicit pipelining.
+       */
+
+      while(n--){
+        std::uint64_t hash;
+        const auto&   x=s(hash);
+        f(x.may_contain(hash));
+      }
+    }
+    else{
+      /* Ring of pending lookups whose first position has been prefetched
+       * pipelined_may_contain_size lookups in advance.
+       */
+
+      std::uint64_t        hashes[pipelined_may_contain_size];
+      const filter_core*   filters[pipelined_may_contain_size];
+      const unsigned char* positions[pipelined_may_contain_size];
+
+      auto fetch=[&](std::size_t i){
+        auto& hash=hashes[i];
+        auto& x=filters[i];
+        x=&s(hash);
+        positions[i]=x->start_may_contain(hash);
+      };
+      auto check=[&](std::size_t i){
+        return filters[i]->finish_may_contain(positions[i],hashes[i]);
+      };
+
+      std::size_t pending=
+        n<pipelined_may_contain_size?n:pipelined_may_contain_size;
+      for(std::size_t i=0;i<pending;++i)fetch(i);
+      n-=pending;
+
+      std::size_t i=0;
+      for(;n;--n){
+        auto res=check(i);
+        fetch(i);
+        f(res);
+        if(++i==pipelined_may_contain_size)i=0;
+      }
+      while(pending--){
+        f(check(i));
+        if(++i==pipelined_may_contain_size)i=0;
+      }
+    }
+  }
+
   friend bool operator==(const filter_core& x,const filter_core& y)
   {
     if(x.range()!=y.range())return false;
@@ -806,10 +1046,13 @@ private:
       }while(fpr_for_c(c0)<fpr);
     }
 
-    /* bisect */
+    /* Bisect. We can stop as soon as c0 and c1 yield the same capacity
+     * (in bits), as all subsequent midpoints would do too.
+     */
 
     double cm;
     while((cm=c0+(c1-c0)/2)>c0 && cm<c1 && c1-c0>=eps){
+      if((std::size_t)(c0*n)==(std::size_t)(c1*n))break;
       if(fpr_for_c(cm)>fpr)c0=cm;
       else                 c1=cm;
     }
@@ -818,13 +1061,23 @@ private:
 
   static double fpr_for_c(double c)
   {
+    constexpr int         max_i=1000;
     constexpr std::size_t w=(2*used_value_size-stride)*CHAR_BIT;
     const double          lambda=w*k/c;
-    const double          loglambda=std::log(lambda);
-    double                res=0.0;
-    double                deltap=0.0;
-    for(int i=0;i<1000;++i){
-      double poisson=std::exp(i*loglambda-lambda-std::lgamma(i+1));
+
+    /* Summation starts at the mode of the Poisson distribution and proceeds
+     * in both directions, with Poisson terms calculated recursively from
+     * the initial one. This evaluates far fewer terms than summing
+     * from i=0, and avoids calling std::exp and std::lgamma for each.
+     */
+
+    const int    mode=lambda<max_i-1?(int)lambda:max_i-1;
+    const double poisson_mode=
+      std::exp(mode*std::log(lambda)-lambda-std::lgamma(mode+1));
+    double       res=0.0;
+    double       deltap=0.0;
+    double       poisson=poisson_mode;
+    for(int i=mode;i<max_i;++i){
       double delta=poisson*subfilter::fpr(i,w);
       double resn=res+delta;
 
@@ -835,6 +1088,18 @@ private:
       if(delta<deltap&&resn==res)break;
       deltap=delta;
       res=resn;
+      poisson*=lambda/(i+1);
+    }
+    poisson=poisson_mode;
+    for(int i=mode;i-->0;){
+      poisson*=(i+1)/lambda;
+      double delta=poisson*subfilter::fpr(i,w);
+      double resn=res+delta;
+
+      /* below the mode, terms decrease monotonically */
+
+      if(resn==res)break;
+      res=resn;
     }
 
     /* For small values of c (high values of lambda), truncation errors,loop
@@ -891,6 +1156,14 @@ private:
     std::memcpy(p,&x,block_size);
   }
 
+  BOOST_FORCEINLINE void prefetch_element(std::size_t pos)noexcept
+  {
+    auto p=ar.array+pos*stride;
+    for(std::size_t i=0;i<prefetched_cachelines;++i){
+      BOOST_BLOOM_PREFETCH_WRITE((unsigned char*)p+i*cacheline);
+    }
+  }
+
   BOOST_FORCEINLINE 
   unsigned char* next_element(std::uint64_t& h)noexcept
   {
@@ -911,6 +1184,109 @@ private:
     return p;
   }
 
+  /* Performs the k rounds of checks of a bulk_may_contain chunk, clearing
+   * the bits of results for the elements found not to be in the filter.
+   * The masked variant skips elements already discarded, which is best when
+   * most lookups are unsuccessful; the branchless variant checks every
+   * element at each round and avoids the bookkeeping and mispredictions of
+   * the former when most lookups are successful.
+   */
+
+  BOOST_FORCEINLINE void bulk_may_contain_rounds(
+    std::uint64_t* hashes,const unsigned char** positions,
+    std::uint64_t& results,bool branchless)const
+  {
+    if(branchless){
+      for(auto j=k;j--;){
+        for(std::size_t i=0;i<bulk_may_contain_size;++i){
+          auto& hash=hashes[i];
+          auto& p=positions[i];
+          auto  b=get(p,hash);
+          p=next_element(hash);
+          results&=~(std::uint64_t(!b)<<i);
+        }
+      }
+    }
+    else{
+      for(auto j=k;j--;){
+        auto mask=results;
+        if(!mask)break;
+        do{
+          auto i=unchecked_countr_zero(mask);
+          auto& hash=hashes[i];
+          auto& p=positions[i];
+          auto  b=get(p,hash);
+          p=next_element(hash);
+          results&=~(std::uint64_t(!b)<<i);
+          mask&=mask-1;
+        }while(mask);
+      }
+    }
+  }
+
+  /* Decides on the variant for the next chunk based on the hit rate of
+   * the current one.
+   */
+
+  static bool use_branchless_rounds(std::uint64_t results)noexcept
+  {
+    return
+      (std::size_t)boost::core::popcount(results)*100>=
+      branchless_lookup_threshold*bulk_may_contain_size;
+  }
+
+  /* Positions for a whole batch are calculated and prefetched while the
+   * previous batch is looked up vertical_check_size elements at a time.
+   */
+
+  template<typename HashStream,typename F>
+  void vertical_bulk_may_contain(
+    HashStream h,std::size_t n,F f,std::true_type)const
+  {
+    static constexpr std::size_t batch_size=bulk_may_contain_size;
+
+    std::uint64_t hashes[2][batch_size];
+    std::uint64_t offsets[2][batch_size];
+    std::size_t   cur=0;
+
+    auto fetch=[&](std::size_t j){
+      for(std::size_t i=0;i<batch_size;++i){
+        auto& hash=hashes[j][i]=h();
+        hs.prepare_hash(hash);
+        offsets[j][i]=(std::uint64_t)(next_element(hash)-ar.array);
+      }
+    };
+    auto check=[&](std::size_t j){
+      for(std::size_t i=0;i<batch_size;i+=vertical_check_size){
+        auto res=subfilter::vertical_check(
+          ar.array,offsets[j]+i,hashes[j]+i);
+        for(std::size_t l=0;l<vertical_check_size;++l){
+          f(res&1);
+          res>>=1;
+        }
+      }
+    };
+
+    if(n>=2*batch_size){
+      fetch(cur);
+      n-=batch_size;
+      do{
+        fetch(cur^1);
+        n-=batch_size;
+        check(cur);
+        cur^=1;
+      }while(n>=batch_size);
+      check(cur);
+    }
+
+    while(n--)f(may_contain(h()));
+  }
+
+  template<typename HashStream,typename F>
+  void vertical_bulk_may_contain(HashStream,std::size_t,F,std::false_type)const
+  {
+  }
+
   template<typename F>
   void combine(const filter_core& x,F f)
   {
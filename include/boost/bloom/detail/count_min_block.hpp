@@ -0,0 +1,109 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COUNT_MIN_BLOCK_HPP
+#define BOOST_BLOOM_DETAIL_COUNT_MIN_BLOCK_HPP
+
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Subfilter for count_min_sketch: a cache line of counters split into Depth
+ * contiguous segments, one per row of the sketch. The counter for row i is
+ * selected within segment i with fastrange on the i-th slice of 64/Depth
+ * bits (at most 32) of the hash, starting from the most significant ones.
+ * As segments don't overlap, the Depth counters of an element are always
+ * distinct.
+ */
+
+template<typename Counter,std::size_t Depth>
+struct count_min_block
+{
+  static_assert(
+    is_unsigned_integral_or_extended_unsigned_integral<Counter>::value,
+    "Counter must be an (extended) unsigned integral type");
+  static constexpr std::size_t k=1;
+  static constexpr std::size_t depth=Depth;
+  static constexpr std::size_t num_counters=
+    BOOST_BLOOM_CACHELINE_SIZE/sizeof(Counter);
+  static_assert(
+    Depth>0&&Depth<=num_counters&&Depth<=64,
+    "Depth must be in [1, min(64, number of counters per cache line)]");
+  using value_type=Counter[num_counters];
+  static constexpr Counter max_counter=(std::numeric_limits<Counter>::max)();
+
+  /* conservative update: only the minimum counters are incremented */
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    Counter m=estimate(x,hash),
+            inc=m!=max_counter;
+    loop(hash,[&](std::size_t pos){
+      x[pos]=(Counter)(x[pos]+((x[pos]==m)&inc));
+    });
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    return estimate(x,hash)!=0;
+  }
+
+  static BOOST_FORCEINLINE Counter estimate(
+    const value_type& x,std::uint64_t hash)
+  {
+    Counter m=max_counter;
+    loop(hash,[&](std::size_t pos){m=x[pos]<m?x[pos]:m;});
+    return m;
+  }
+
+private:
+  static constexpr std::size_t slice_width=64/Depth<32?64/Depth:32;
+
+  /* Positions are recalculated rather than stored between the two passes
+   * of mark, which is cheaper than going through a temporary array. The
+   * loop is unrolled at compile time so that segment bounds are constants.
+   */
+
+  template<std::size_t I=0,typename F>
+  static BOOST_FORCEINLINE typename std::enable_if<(I<Depth)>::type
+  loop(std::uint64_t hash,F f)
+  {
+    static constexpr std::size_t first=I*num_counters/Depth,
+                                 last=(I+1)*num_counters/Depth;
+    std::uint64_t slice=
+      (hash>>(64-(I+1)*slice_width))&((std::uint64_t(1)<<slice_width)-1);
+    f(first+(std::size_t)((slice*(last-first))>>slice_width));
+    loop<I+1>(hash,f);
+  }
+
+  template<std::size_t I,typename F>
+  static BOOST_FORCEINLINE typename std::enable_if<(I>=Depth)>::type
+  loop(std::uint64_t,F){}
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
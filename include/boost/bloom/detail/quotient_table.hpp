@@ -0,0 +1,490 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_QUOTIENT_TABLE_HPP
+#define BOOST_BLOOM_DETAIL_QUOTIENT_TABLE_HPP
+
+#include <boost/bloom/detail/core.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* position of the k-th (0-based) set bit of x */
+
+BOOST_FORCEINLINE std::size_t select64(std::uint64_t x,unsigned int k)noexcept
+{
+#if defined(__BMI2__)
+  return (std::size_t)boost::core::countr_zero(
+    _pdep_u64(std::uint64_t(1)<<k,x));
+#else
+  for(;k;--k)x&=x-1;
+  return (std::size_t)boost::core::countr_zero(x);
+#endif
+}
+
+/* Slot table of a counting quotient filter with the rank-and-select layout
+ * of Pandey et al. (2017). An F-bit fingerprint is split into a qbits-bit
+ * quotient (its home slot) and an rbits-bit remainder, rbits being set at
+ * run time. Each distinct remainder of a quotient is stored once, followed
+ * by the digits of its multiplicity minus one in base 2^rbits, least
+ * significant first and with no trailing zero digits, so that a
+ * fingerprint inserted c times takes 1+ceil(log_{2^rbits}(c)) slots.
+ * Remainders with the same quotient are stored in ascending order in a run
+ * of contiguous slots, runs are ordered by quotient and start at their home
+ * slot or right after the previous run, whichever comes last. Slots are
+ * grouped in blocks of 64, each holding:
+ *   - occupieds: bit i is set if quotient 64*b+i has a run,
+ *   - runends: bit i is set if slot 64*b+i is the last of its run,
+ *   - offset: number of slots from 64*b on taken by runs with quotient
+ *     < 64*b,
+ *   - digits: bit i is set if slot 64*b+i holds a counter digit rather
+ *     than a remainder,
+ *   - the 64 slots, packed in rbits words.
+ * The end of the run for quotient x is then found by counting the occupied
+ * quotients in [64*b,x] (rank) and locating the corresponding runend past
+ * the block offset (select). Slots beyond the 2^qbits quotients absorb
+ * runs spilling past the last quotient.
+ *
+ * quotient_table does not own its memory, which is managed by
+ * quotient_filter.
+ */
+
+struct quotient_table
+{
+  static constexpr std::size_t metadata_words=4;
+
+  static std::size_t blocks_for(std::size_t qbits)noexcept
+  {
+    std::size_t quotients=std::size_t(1)<<qbits,
+                extra=
+                  (std::size_t)(10.0*std::sqrt((double)quotients))/64+2;
+    return quotients/64+extra;
+  }
+
+  std::size_t block_words()const noexcept{return metadata_words+rbits;}
+  std::size_t num_slots()const noexcept{return num_blocks*64;}
+  std::size_t num_words()const noexcept{return num_blocks*block_words();}
+
+  BOOST_FORCEINLINE void split(
+    std::uint64_t hash,std::size_t& q,std::uint64_t& r)const noexcept
+  {
+    auto f=hash>>(64-qbits-rbits);
+    q=(std::size_t)(f>>rbits);
+    r=f&mask();
+  }
+
+  BOOST_FORCEINLINE void prefetch(std::size_t q)const noexcept
+  {
+    auto p=(const unsigned char*)block(q/64);
+    BOOST_BLOOM_PREFETCH(p);
+    BOOST_BLOOM_PREFETCH(p+metadata_words*8+(q%64)*rbits/8);
+  }
+
+  BOOST_FORCEINLINE bool contains(std::size_t q,std::uint64_t r)const noexcept
+  {
+    if(!is_occupied(q))return false;
+    std::size_t j=run_end(q);
+    do{
+      if(!is_digit(--j)){
+        auto x=slot(j);
+        if(x==r)return true;
+        if(x<r)return false;
+      }
+    }while(j>q&&!is_runend(j-1));
+    return false;
+  }
+
+  std::size_t count(std::size_t q,std::uint64_t r)const noexcept
+  {
+    if(!is_occupied(q))return 0;
+    std::size_t end=run_end(q),p=find(r,run_start(q,end),end);
+    if(p==end||slot(p)!=r)return 0;
+    std::size_t c=1;
+    for(std::size_t j=p+1,s=0;j<end&&is_digit(j);++j,s+=rbits){
+      add_digit(c,slot(j),s);
+    }
+    return c;
+  }
+
+  /* returns false if there is no free slot past the run */
+
+  bool insert(std::size_t q,std::uint64_t r)noexcept
+  {
+    if(!is_occupied(q)){
+      std::size_t p=q?run_end(q-1):0;
+      if(p<q)p=q;
+      if(!insert_slot(q,p,p,false,r,false))return false;
+      ++distinct;
+      return true;
+    }
+
+    std::size_t end=run_end(q),p=find(r,run_start(q,end),end);
+    if(p==end||slot(p)!=r){
+      if(!insert_slot(q,p,end,true,r,false))return false;
+      ++distinct;
+      return true;
+    }
+
+    /* existing remainder: increment its counter, adding a digit when all
+     * present digits are at their maximum
+     */
+
+    std::size_t j=p+1;
+    while(j<end&&is_digit(j)&&slot(j)==mask())++j;
+    if(j<end&&is_digit(j))set_slot(j,slot(j)+1);
+    else if(!insert_slot(q,j,end,true,1,true))return false;
+    for(std::size_t i=p+1;i<j;++i)set_slot(i,0);
+    return true;
+  }
+
+  bool erase(std::size_t q,std::uint64_t r)noexcept
+  {
+    if(!is_occupied(q))return false;
+    std::size_t end=run_end(q),start=run_start(q,end),p=find(r,start,end);
+    if(p==end||slot(p)!=r)return false;
+
+    /* decrement the counter, removing its most significant digit if it
+     * becomes zero, or remove the remainder if it had no counter
+     */
+
+    std::size_t j=p+1;
+    while(j<end&&is_digit(j)&&slot(j)==0)++j;
+    if(j<end&&is_digit(j)){
+      for(std::size_t i=p+1;i<j;++i)set_slot(i,mask());
+      auto d=slot(j)-1;
+      if(d||(j+1<end&&is_digit(j+1)))set_slot(j,d);
+      else remove_slot(q,j,start,end);
+    }
+    else{
+      remove_slot(q,p,start,end);
+      --distinct;
+    }
+    return true;
+  }
+
+  /* Visits (fingerprint,count) pairs in ascending order of fingerprint. */
+
+  struct cursor
+  {
+    explicit cursor(const quotient_table& t_)noexcept:
+      t(t_),w(t.num_blocks?t.block(0)[0]:0){}
+
+    bool next(std::uint64_t& f,std::size_t& c)noexcept
+    {
+      if(!in_run){
+        while(!w){
+          if(++b>=t.num_blocks)return false;
+          w=t.block(b)[0];
+        }
+        q=b*64+(std::size_t)boost::core::countr_zero(w);
+        w&=w-1;
+        if(pos<q)pos=q;
+      }
+      f=((std::uint64_t)q<<t.rbits)|t.slot(pos);
+      c=1;
+      bool end=t.is_runend(pos);
+      for(std::size_t s=0;!end&&t.is_digit(pos+1);s+=t.rbits){
+        t.add_digit(c,t.slot(++pos),s);
+        end=t.is_runend(pos);
+      }
+      ++pos;
+      in_run=!end;
+      return true;
+    }
+
+    const quotient_table& t;
+    std::size_t           b=0,q=0,pos=0;
+    std::uint64_t         w;
+    bool                  in_run=false;
+  };
+
+  /* Builds the table (assumed to be zeroed) from (fingerprint,count) pairs
+   * provided in ascending order of fingerprint by src, adding up the counts
+   * of equal consecutive fingerprints. Returns false on overflow.
+   */
+
+  template<typename Source>
+  bool assign(Source& src)noexcept
+  {
+    std::uint64_t f,nf=0;
+    std::size_t   c,nc=0,pos=0,last_q=num_slots(),next_block=0;
+    bool          more=src.next(f,c);
+    while(more){
+      while((more=src.next(nf,nc))&&nf==f)c+=nc;
+
+      std::size_t q=(std::size_t)(f>>rbits);
+      if(q!=last_q){
+        if(pos)set_runend(pos-1);
+        for(;next_block*64<=q;++next_block){
+          if(pos>next_block*64)block(next_block)[2]=pos-next_block*64;
+        }
+        block(q/64)[0]|=std::uint64_t(1)<<(q%64);
+        if(pos<q)pos=q;
+        last_q=q;
+      }
+      if(pos>=num_slots())return false;
+      set_slot(pos++,f&mask());
+      ++used;
+      for(std::uint64_t v=c-1;v;v>>=rbits){
+        if(pos>=num_slots())return false;
+        set_slot(pos,v&mask());
+        set_digit(pos++);
+        ++used;
+      }
+      ++distinct;
+      f=nf;
+      c=nc;
+    }
+    if(pos)set_runend(pos-1);
+    for(;next_block<num_blocks;++next_block){
+      if(pos>next_block*64)block(next_block)[2]=pos-next_block*64;
+    }
+    return true;
+  }
+
+  BOOST_FORCEINLINE std::uint64_t* block(std::size_t b)const noexcept
+  {
+    return words+b*block_words();
+  }
+
+  BOOST_FORCEINLINE std::uint64_t mask()const noexcept
+  {
+    return (std::uint64_t(1)<<rbits)-1;
+  }
+
+  BOOST_FORCEINLINE std::uint64_t slot(std::size_t j)const noexcept
+  {
+    auto          p=block(j/64)+metadata_words;
+    std::size_t   n=(j%64)*rbits,i=n/64,s=n%64;
+    std::uint64_t x=p[i]>>s;
+    if(s+rbits>64)x|=p[i+1]<<(64-s);
+    return x&mask();
+  }
+
+  BOOST_FORCEINLINE void set_slot(std::size_t j,std::uint64_t x)noexcept
+  {
+    auto        p=block(j/64)+metadata_words;
+    std::size_t n=(j%64)*rbits,i=n/64,s=n%64;
+    p[i]=(p[i]&~(mask()<<s))|(x<<s);
+    if(s+rbits>64)p[i+1]=(p[i+1]&~(mask()>>(64-s)))|(x>>(64-s));
+  }
+
+  static void add_digit(
+    std::size_t& c,std::uint64_t d,std::size_t s)noexcept
+  {
+    if(s<64)c+=(std::size_t)(d<<s);
+  }
+
+  BOOST_FORCEINLINE bool is_occupied(std::size_t q)const noexcept
+  {
+    return (block(q/64)[0]>>(q%64))&1;
+  }
+
+  BOOST_FORCEINLINE bool is_runend(std::size_t j)const noexcept
+  {
+    return (block(j/64)[1]>>(j%64))&1;
+  }
+
+  BOOST_FORCEINLINE bool is_digit(std::size_t j)const noexcept
+  {
+    return (block(j/64)[3]>>(j%64))&1;
+  }
+
+  void set_runend(std::size_t j)noexcept
+  {
+    block(j/64)[1]|=std::uint64_t(1)<<(j%64);
+  }
+
+  void reset_runend(std::size_t j)noexcept
+  {
+    block(j/64)[1]&=~(std::uint64_t(1)<<(j%64));
+  }
+
+  void set_digit(std::size_t j)noexcept
+  {
+    block(j/64)[3]|=std::uint64_t(1)<<(j%64);
+  }
+
+  void reset_digit(std::size_t j)noexcept
+  {
+    block(j/64)[3]&=~(std::uint64_t(1)<<(j%64));
+  }
+
+  /* One past the last slot of the run of the greatest occupied quotient
+   * <=x, or a value <=x if no such run reaches x.
+   */
+
+  BOOST_FORCEINLINE std::size_t run_end(std::size_t x)const noexcept
+  {
+    auto        p=block(x/64);
+    std::size_t base=x/64*64+(std::size_t)p[2];
+    auto        d=(unsigned int)boost::core::popcount(
+                  p[0]&((std::uint64_t(2)<<(x%64))-1));
+    if(d==0)return base;
+    std::size_t b=base/64;
+    auto        w=block(b)[1]&(~std::uint64_t(0)<<(base%64));
+    for(;;){
+      auto c=(unsigned int)boost::core::popcount(w);
+      if(d<=c)return b*64+select64(w,d-1)+1;
+      d-=c;
+      w=block(++b)[1];
+    }
+  }
+
+  std::size_t run_start(std::size_t q,std::size_t end)const noexcept
+  {
+    std::size_t j=end-1;
+    while(j>q&&!is_runend(j-1))--j;
+    return j;
+  }
+
+  /* position in [start,end) of the first remainder not less than r, or end
+   * if none
+   */
+
+  std::size_t find(
+    std::uint64_t r,std::size_t start,std::size_t end)const noexcept
+  {
+    std::size_t p=start;
+    while(p<end&&slot(p)<r){
+      do ++p; while(p<end&&is_digit(p));
+    }
+    return p;
+  }
+
+  std::size_t first_unused(std::size_t x)const noexcept
+  {
+    while(x<num_slots()){
+      std::size_t t=run_end(x);
+      if(t<=x)return x;
+      x=t;
+    }
+    return x;
+  }
+
+  /* first occupied quotient in [first,last), or last if none */
+
+  std::size_t next_occupied(std::size_t first,std::size_t last)const noexcept
+  {
+    if(first>=last)return last;
+    std::size_t b=first/64;
+    auto        w=block(b)[0]&(~std::uint64_t(0)<<(first%64));
+    while(!w){
+      if(++b*64>=last)return last;
+      w=block(b)[0];
+    }
+    std::size_t q=b*64+(std::size_t)boost::core::countr_zero(w);
+    return q<last?q:last;
+  }
+
+  /* Inserts x at position p of the run of q, which ends at end if
+   * occupied, shifting the following slots up to the first unused one.
+   */
+
+  bool insert_slot(
+    std::size_t q,std::size_t p,std::size_t end,bool occupied,
+    std::uint64_t x,bool digit)noexcept
+  {
+    std::size_t e=first_unused(occupied?end:p);
+    if(e>=num_slots())return false;
+
+    shift_right(p,e);
+    set_slot(p,x);
+    if(digit)set_digit(p);
+    else reset_digit(p);
+    if(!occupied){
+      set_runend(p);
+      block(q/64)[0]|=std::uint64_t(1)<<(q%64);
+    }
+    else if(p==end){
+      reset_runend(end-1);
+      set_runend(p);
+    }
+    else reset_runend(p);
+    for(std::size_t b=q/64+1;b*64<=e;++b)++block(b)[2];
+    ++used;
+    return true;
+  }
+
+  /* Removes slot p of the run of q spanning [start,end). Runs following
+   * that of q are moved back one slot up to the first one starting at its
+   * home slot.
+   */
+
+  void remove_slot(
+    std::size_t q,std::size_t p,std::size_t start,std::size_t end)noexcept
+  {
+    std::size_t last=end;
+    for(std::size_t g=next_occupied(q+1,last);g<last;
+        g=next_occupied(g+1,last)){
+      last=run_end(g);
+    }
+
+    if(end-start==1)block(q/64)[0]&=~(std::uint64_t(1)<<(q%64));
+    else if(p==end-1)set_runend(end-2);
+    shift_left(p,last);
+    for(std::size_t b=q/64+1;b*64<last;++b)--block(b)[2];
+    --used;
+  }
+
+  void copy_slot(std::size_t to,std::size_t from)noexcept
+  {
+    set_slot(to,slot(from));
+    if(is_runend(from))set_runend(to);
+    else reset_runend(to);
+    if(is_digit(from))set_digit(to);
+    else reset_digit(to);
+  }
+
+  /* moves slots [first,last) to [first+1,last] */
+
+  void shift_right(std::size_t first,std::size_t last)noexcept
+  {
+    for(std::size_t j=last;j>first;--j)copy_slot(j,j-1);
+  }
+
+  /* moves slots [first+1,last) to [first,last-1) and clears slot last-1 */
+
+  void shift_left(std::size_t first,std::size_t last)noexcept
+  {
+    for(std::size_t j=first;j+1<last;++j)copy_slot(j,j+1);
+    set_slot(last-1,0);
+    reset_runend(last-1);
+    reset_digit(last-1);
+  }
+
+  std::uint64_t* words=nullptr;
+  std::size_t    num_blocks=0;
+  std::size_t    qbits=0,rbits=0;
+  std::size_t    used=0;     /* slots in use */
+  std::size_t    distinct=0; /* distinct fingerprints */
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
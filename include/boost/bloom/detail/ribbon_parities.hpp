@@ -0,0 +1,121 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_RIBBON_PARITIES_HPP
+#define BOOST_BLOOM_DETAIL_RIBBON_PARITIES_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Returns a mask whose j-th bit is the parity of (p[j]&c0)^(q[j]&c1),
+ * for j in [0,N). With SIMD, parities of several words are calculated at
+ * once by xor-folding each word down to 4 bits, which are then used as a
+ * shift into the 16-bit parity table 0x6996.
+ */
+
+#if defined(BOOST_BLOOM_AVX512)
+template<std::size_t N>
+BOOST_FORCEINLINE std::uint32_t ribbon_parities(
+  const std::uint64_t* p,std::uint64_t c0,
+  const std::uint64_t* q,std::uint64_t c1)
+{
+  const __m512i v0=_mm512_set1_epi64((long long)c0),
+                v1=_mm512_set1_epi64((long long)c1),
+                nibble=_mm512_set1_epi64(15),
+                table=_mm512_set1_epi64(0x6996),
+                one=_mm512_set1_epi64(1);
+
+  std::uint32_t res=0;
+  for(std::size_t j=0;j<N;j+=8){
+    const __mmask8 m=
+      (__mmask8)(N-j>=8?0xFFu:(1u<<(N-j))-1);
+    __m512i x=_mm512_xor_si512(
+      _mm512_and_si512(_mm512_maskz_loadu_epi64(m,p+j),v0),
+      _mm512_and_si512(_mm512_maskz_loadu_epi64(m,q+j),v1));
+    x=_mm512_xor_si512(x,mm512_srli_epi64(x,32));
+    x=_mm512_xor_si512(x,mm512_srli_epi64(x,16));
+    x=_mm512_xor_si512(x,mm512_srli_epi64(x,8));
+    x=_mm512_xor_si512(x,mm512_srli_epi64(x,4));
+    x=mm512_srlv_epi64(table,_mm512_and_si512(x,nibble));
+    res|=(std::uint32_t)_mm512_test_epi64_mask(x,one)<<j;
+  }
+  return res;
+}
+#elif defined(BOOST_BLOOM_AVX2)
+template<std::size_t N>
+BOOST_FORCEINLINE std::uint32_t ribbon_parities(
+  const std::uint64_t* p,std::uint64_t c0,
+  const std::uint64_t* q,std::uint64_t c1)
+{
+  const __m256i v0=_mm256_set1_epi64x((long long)c0),
+                v1=_mm256_set1_epi64x((long long)c1),
+                nibble=_mm256_set1_epi64x(15),
+                table=_mm256_set1_epi64x(0x6996),
+                lanes=_mm256_setr_epi64x(0,1,2,3);
+
+  std::uint32_t res=0;
+  for(std::size_t j=0;j<N;j+=4){
+    __m256i a,b;
+    if(N-j>=4){
+      a=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+j));
+      b=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q+j));
+    }
+    else{
+      const __m256i m=_mm256_cmpgt_epi64(
+        _mm256_set1_epi64x((long long)(N-j)),lanes);
+      a=_mm256_maskload_epi64(reinterpret_cast<const long long*>(p+j),m);
+      b=_mm256_maskload_epi64(reinterpret_cast<const long long*>(q+j),m);
+    }
+    __m256i x=_mm256_xor_si256(
+      _mm256_and_si256(a,v0),_mm256_and_si256(b,v1));
+    x=_mm256_xor_si256(x,_mm256_srli_epi64(x,32));
+    x=_mm256_xor_si256(x,_mm256_srli_epi64(x,16));
+    x=_mm256_xor_si256(x,_mm256_srli_epi64(x,8));
+    x=_mm256_xor_si256(x,_mm256_srli_epi64(x,4));
+    x=_mm256_srlv_epi64(table,_mm256_and_si256(x,nibble));
+    res|=(std::uint32_t)_mm256_movemask_pd(
+      _mm256_castsi256_pd(_mm256_slli_epi64(x,63)))<<j;
+  }
+  return res;
+}
+#else
+template<std::size_t N>
+BOOST_FORCEINLINE std::uint32_t ribbon_parities(
+  const std::uint64_t* p,std::uint64_t c0,
+  const std::uint64_t* q,std::uint64_t c1)
+{
+  std::uint32_t res=0;
+  for(std::size_t j=0;j<N;++j){
+    res|=(std::uint32_t)(
+      boost::core::popcount((p[j]&c0)^(q[j]&c1))&1)<<j;
+  }
+  return res;
+}
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
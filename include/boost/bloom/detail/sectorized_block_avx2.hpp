@@ -0,0 +1,135 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_AVX2_HPP
+#define BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_AVX2_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/sectorized_block_impl.hpp>
+#include <boost/config.hpp>
+#include <boost/config/workaround.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* A round sets one bit in each of 4 (one __m256i) or 8 (two __m256i)
+ * std::uint64_t sectors at once.
+ */
+
+template<std::size_t Sectors,std::size_t K>
+struct sectorized_block_impl<
+  std::uint64_t,Sectors,K,
+  typename std::enable_if<Sectors==4||Sectors==8>::type
+>
+{
+  using value_type=std::uint64_t[Sectors];
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<K/Sectors;++i){
+      mark_round(x,hash,Sectors);
+      hash=detail::mulx64(hash);
+    }
+    if(K%Sectors){
+      mark_round(x,hash,K%Sectors);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    bool res=true;
+    for(std::size_t i=0;i<K/Sectors;++i){
+      res&=check_round(x,hash,Sectors);
+      hash=detail::mulx64(hash);
+    }
+    if(K%Sectors){
+      res&=check_round(x,hash,K%Sectors);
+    }
+    return res;
+  }
+
+private:
+  /* bits for sectors 4*j,...,4*j+3, only the first kp sectors of the
+   * round being marked.
+   */
+
+  static BOOST_FORCEINLINE __m256i make_m256i(
+    std::uint64_t hash,std::size_t j,std::size_t kp)
+  {
+    const __m256i ones[4]={
+      _mm256_set_epi64x(0,0,0,1),
+      _mm256_set_epi64x(0,0,1,1),
+      _mm256_set_epi64x(0,1,1,1),
+      _mm256_set_epi64x(1,1,1,1)
+    };
+
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_srlv_epi64(
+      h,
+      j==0?
+        _mm256_set_epi64x(24,18,12,6):
+        _mm256_set_epi64x(48,42,36,30));
+    h=_mm256_and_si256(h,_mm256_set1_epi64x(63));
+    return _mm256_sllv_epi64(ones[(kp-4*j<4?kp-4*j:4)-1],h);
+  }
+
+  static BOOST_FORCEINLINE void mark_round(
+    value_type& x,std::uint64_t hash,std::size_t kp)
+  {
+    for(std::size_t j=0;j<Sectors/4;++j){
+      if(kp>4*j){
+        __m256i* p=reinterpret_cast<__m256i*>(x+4*j);
+        _mm256_storeu_si256(
+          p,_mm256_or_si256(_mm256_loadu_si256(p),make_m256i(hash,j,kp)));
+      }
+    }
+  }
+
+#if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
+/* 'int': forcing value to bool 'true' or 'false' */
+#pragma warning(push)
+#pragma warning(disable:4800)
+#endif
+
+  static BOOST_FORCEINLINE bool check_round(
+    const value_type& x,std::uint64_t hash,std::size_t kp)
+  {
+    int res=1;
+    for(std::size_t j=0;j<Sectors/4;++j){
+      if(kp>4*j){
+        const __m256i* p=reinterpret_cast<const __m256i*>(x+4*j);
+        res&=_mm256_testc_si256(
+          _mm256_loadu_si256(p),make_m256i(hash,j,kp));
+      }
+    }
+    return res;
+  }
+
+#if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
+#pragma warning(pop) /* C4800 */
+#endif
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
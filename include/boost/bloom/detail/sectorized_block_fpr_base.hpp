@@ -0,0 +1,42 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_FPR_BASE_HPP
+#define BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_FPR_BASE_HPP
+
+#include <cmath>
+#include <cstddef>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* K%Sectors sectors get K/Sectors+1 bits, the rest get K/Sectors bits. */
+
+template<std::size_t Sectors,std::size_t K>
+struct sectorized_block_fpr_base
+{
+  static double fpr(std::size_t i,std::size_t w)
+  {
+    return
+      std::pow(sector_fpr(i,w,K/Sectors),(double)(Sectors-K%Sectors))*
+      std::pow(sector_fpr(i,w,K/Sectors+1),(double)(K%Sectors));
+  }
+
+private:
+  static double sector_fpr(std::size_t i,std::size_t w,std::size_t kp)
+  {
+    return std::pow(
+      1.0-std::pow(1.0-(double)Sectors/w,(double)kp*i),(double)kp);
+  }
+};
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,100 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_IMPL_HPP
+#define BOOST_BLOOM_DETAIL_SECTORIZED_BLOCK_IMPL_HPP
+
+#include <boost/bloom/detail/block_base.hpp>
+#include <boost/bloom/detail/block_ops.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/config/workaround.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Bits are set in rounds of one bit per sector. Each round takes the
+ * positions for sectors 0,1,... from consecutive shift-bit chunks of the
+ * hash value (skipping the lowest chunk) and then rehashes. SIMD
+ * specializations must adhere to this scheme so that the resulting
+ * filter contents are platform independent.
+ */
+
+template<
+  typename Block,std::size_t Sectors,std::size_t K,typename=void
+>
+struct sectorized_block_impl:private block_base<Block,K>
+{
+  using value_type=Block[Sectors];
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline void mark(value_type& x,std::uint64_t hash)
+  {
+    loop(hash,[&](std::size_t s,std::uint64_t h){
+      block_ops::set(x[s],h&mask);
+    });
+  }
+
+#if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
+/* 'int': forcing value to bool 'true' or 'false' */
+#pragma warning(push)
+#pragma warning(disable:4800)
+#endif
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool check(const value_type& x,std::uint64_t hash)
+  {
+    int res=1;
+    loop(hash,[&](std::size_t s,std::uint64_t h){
+      block_ops::reduce(res,x[s],h&mask);
+    });
+    return res;
+  }
+
+#if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
+#pragma warning(pop) /* C4800 */
+#endif
+
+private:
+  using super=block_base<Block,K>;
+  using super::mask;
+  using super::shift;
+  using super::hash_width;
+  using block_ops=detail::block_ops<Block>;
+
+  static_assert(
+    shift*(Sectors+1)<=hash_width,
+    "Sectors too large for the bits available per round");
+
+  template<typename F>
+  static BOOST_FORCEINLINE void loop(std::uint64_t hash,F f)
+  {
+    for(std::size_t i=0;i<K/Sectors;++i){
+      for(std::size_t s=0;s<Sectors;++s)f(s,hash>>(shift*(s+1)));
+      hash=detail::mulx64(hash);
+    }
+    for(std::size_t s=0;s<K%Sectors;++s)f(s,hash>>(shift*(s+1)));
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
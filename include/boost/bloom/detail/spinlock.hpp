@@ -0,0 +1,70 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_SPINLOCK_HPP
+#define BOOST_BLOOM_DETAIL_SPINLOCK_HPP
+
+#include <atomic>
+#include <boost/bloom/detail/sse2.hpp>
+#include <thread>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Test-and-test-and-set spinlock. Critical sections protected by this
+ * lock are short and non-blocking (insertions into a subarray, bytewise
+ * combination), so we spin for a while before yielding to the OS.
+ */
+
+class spinlock
+{
+public:
+  spinlock()=default;
+  spinlock(const spinlock&)=delete;
+  spinlock& operator=(const spinlock&)=delete;
+
+  void lock()noexcept
+  {
+    for(unsigned int n=0;;){
+      if(!locked.exchange(true,std::memory_order_acquire))return;
+      while(locked.load(std::memory_order_relaxed)){
+        if(++n<spins){
+#if defined(BOOST_BLOOM_SSE2)
+          _mm_pause();
+#endif
+        }
+        else{
+          n=0;
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  bool try_lock()noexcept
+  {
+    return !locked.load(std::memory_order_relaxed)&&
+           !locked.exchange(true,std::memory_order_acquire);
+  }
+
+  void unlock()noexcept
+  {
+    locked.store(false,std::memory_order_release);
+  }
+
+private:
+  static constexpr unsigned int spins=64;
+
+  std::atomic<bool> locked{false};
+};
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,144 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_STABLE_BLOCK_HPP
+#define BOOST_BLOOM_DETAIL_STABLE_BLOCK_HPP
+
+#include <boost/bloom/detail/constexpr_bit_width.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Subfilter for stable_filter: a cache line of CellWidth-bit cells packed
+ * into 64-bit words. mark sets K cells to their maximum value and check
+ * tests that they are all nonzero; decrement lowers a run of cells starting
+ * at a position given by an externally provided random value, saturating
+ * at zero. Cell positions are extracted from the hash as in block_base,
+ * rehashing with mulx64 when its bits run out.
+ */
+
+template<std::size_t K,std::size_t CellWidth>
+struct stable_block
+{
+  static_assert(
+    CellWidth==1||CellWidth==2||CellWidth==4,
+    "CellWidth must be 1, 2 or 4");
+  static_assert(K>0,"K must be greater than zero");
+  static constexpr std::size_t   k=K;
+  static constexpr std::size_t   cell_width=CellWidth;
+  static constexpr std::size_t   num_words=
+    BOOST_BLOOM_CACHELINE_SIZE/sizeof(std::uint64_t);
+  static constexpr std::size_t   num_cells=num_words*64/CellWidth;
+  static constexpr std::uint64_t max_cell=(std::uint64_t(1)<<CellWidth)-1;
+  using value_type=std::uint64_t[num_words];
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    loop(k,hash,[&](std::size_t pos){
+      x[word(pos)]|=max_cell<<offset(pos);
+    });
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    bool res=true;
+    loop(k,hash,[&](std::size_t pos){
+      res&=((x[word(pos)]>>offset(pos))&max_cell)!=0;
+    });
+    return res;
+  }
+
+  /* Decrements the p cells (wrapping around) starting at rnd%num_cells,
+   * plus all the cells p/num_cells times. Cells are handled in parallel
+   * (SWAR): for each word covered by the run, one is subtracted from the
+   * least significant bit of its nonzero cells, so the cost depends on the
+   * number of words touched rather than on p.
+   */
+
+  static BOOST_FORCEINLINE void decrement(
+    value_type& x,std::size_t p,std::uint64_t rnd)
+  {
+    for(std::size_t n=p/num_cells;n--;){
+      for(std::size_t i=0;i<num_words;++i)x[i]-=nonzero_lsbs(x[i]);
+    }
+
+    std::size_t pos=(std::size_t)(rnd&(num_cells-1))*CellWidth,
+                last=pos+p%num_cells*CellWidth;
+    while(pos<last){
+      std::size_t   s=pos%64,
+                    n=64-s<last-pos?64-s:last-pos;
+      std::uint64_t mask=(std::uint64_t(0)-1)>>(64-n)<<s;
+      auto&         w=x[pos/64%num_words];
+      w-=nonzero_lsbs(w)&mask;
+      pos+=n;
+    }
+  }
+
+private:
+  static constexpr std::size_t cells_per_word=64/CellWidth;
+  static constexpr std::size_t shift=constexpr_bit_width(num_cells-1);
+  static constexpr std::size_t rehash_n=(64-shift)/shift;
+  static constexpr std::uint64_t lsbs=
+    ~std::uint64_t(0)/max_cell; /* least significant bit of every cell */
+
+  /* bits set at the least significant position of nonzero cells */
+
+  static BOOST_FORCEINLINE std::uint64_t nonzero_lsbs(std::uint64_t w)
+  {
+    for(std::size_t i=1;i<CellWidth;i<<=1)w|=w>>i;
+    return w&lsbs;
+  }
+
+  static BOOST_FORCEINLINE std::size_t word(std::size_t pos)
+  {
+    return pos/cells_per_word;
+  }
+
+  static BOOST_FORCEINLINE std::size_t offset(std::size_t pos)
+  {
+    return pos%cells_per_word*CellWidth;
+  }
+
+  template<typename F>
+  static BOOST_FORCEINLINE void loop(std::size_t n,std::uint64_t hash,F f)
+  {
+    for(std::size_t i=0;i<n/rehash_n;++i){
+      auto h=hash;
+      for(std::size_t j=0;j<rehash_n;++j){
+        h>>=shift;
+        f((std::size_t)h&(num_cells-1));
+      }
+      hash=detail::mulx64(hash);
+    }
+    auto h=hash;
+    for(std::size_t i=0;i<n%rehash_n;++i){
+      h>>=shift;
+      f((std::size_t)h&(num_cells-1));
+    }
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
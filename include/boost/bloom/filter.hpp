@@ -62,6 +62,14 @@ struct mulx64_mix_policy
   }
 };
 
+template<typename Hash>
+using mix_policy_for=typename std::conditional<
+  boost::hash_is_avalanching<Hash>::value&&
+  sizeof(std::size_t)>=sizeof(std::uint64_t),
+  no_mix_policy,
+  mulx64_mix_policy
+>::type;
+
 } /* namespace detail */
 
 #if defined(BOOST_MSVC)
@@ -91,12 +99,7 @@ filter:
     std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
     "Allocator's value_type must be unsigned char");
   using super=detail::filter_core<K,Subfilter,Stride,Allocator>;
-  using mix_policy=typename std::conditional<
-    boost::hash_is_avalanching<Hash>::value&&
-    sizeof(std::size_t)>=sizeof(std::uint64_t),
-    detail::no_mix_policy,
-    detail::mulx64_mix_policy
-  >::type;
+  using mix_policy=detail::mix_policy_for<Hash>;
 
 public:
   using value_type=T;
@@ -261,6 +264,27 @@ public:
     insert(il.begin(),il.end());
   }
 
+  template<typename Generator>
+  void insert_from(Generator g)
+  {
+    buffered_insert([&](std::uint64_t& hash){
+      auto x=g();
+      if(!x)return false;
+      hash=promoting_hash_for(*x);
+      return true;
+    });
+  }
+
+  template<typename ForwardIterator>
+  void partitioned_insert(ForwardIterator first,ForwardIterator last)
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    super::partitioned_bulk_insert(
+      [this,first]()mutable{return promoting_hash_for(*first++);},
+      static_cast<std::size_t>(std::distance(first,last)));
+  }
+
   void swap(filter& x)
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
@@ -324,6 +348,18 @@ private:
   bool friend operator==(
     const filter<T1,K1,SF,S,H,A>& x,const filter<T1,K1,SF,S,H,A>& y);
 
+  template<typename ForwardIterator,typename U,typename F>
+  void friend multi_may_contain(ForwardIterator,ForwardIterator,const U&,F);
+
+  template<
+    typename FilterForwardIterator,typename ForwardIterator,typename F
+  >
+  void friend multi_may_contain(
+    FilterForwardIterator,FilterForwardIterator,
+    ForwardIterator,ForwardIterator,F);
+
+  template<typename,typename,typename> friend class lookup_pipeline;
+
   using hash_base=empty_value<Hash,0>;
 
   const Hash& h()const{return hash_base::get();}
@@ -356,11 +392,95 @@ private:
     return hash_for(x);
   }
 
+  /* (filter,element) pairs are traversed element-major so that each element
+   * is hashed only once. When k==1, lookups are not pipelined across
+   * elements (see filter_core::bulk_multi_may_contain).
+   */
+
+  template<typename FilterIterator,typename Iterator,typename F>
+  static void multi_may_contain_impl(
+    FilterIterator first1,FilterIterator last1,
+    Iterator first2,Iterator last2,F& f,std::true_type /* k==1 */)
+  {
+    const auto    n=static_cast<std::size_t>(std::distance(first1,last1));
+    const filter& x=*first1;
+    for(;first2!=last2;++first2){
+      const std::uint64_t hash=x.promoting_hash_for(*first2);
+      auto                it1=first1,res_it1=first1;
+      super::bulk_multi_may_contain(
+        [&](std::uint64_t& h)->const super&{
+          h=hash;
+          return *it1++;
+        },
+        n,
+        [&](bool res){f(*res_it1++,*first2,res);});
+    }
+  }
+
+  template<typename FilterIterator,typename Iterator,typename F>
+  static void multi_may_contain_impl(
+    FilterIterator first1,FilterIterator last1,
+    Iterator first2,Iterator last2,F& f,std::false_type /* k>1 */)
+  {
+    auto          it1=first1,res_it1=first1;
+    auto          it2=first2,res_it2=first2;
+    std::uint64_t hash=0;
+    super::bulk_multi_may_contain(
+      [&](std::uint64_t& h)->const super&{
+        if(it1==first1)hash=(*first1).promoting_hash_for(*it2);
+        h=hash;
+        const super& x=*it1;
+        if(++it1==last1){
+          it1=first1;
+          ++it2;
+        }
+        return x;
+      },
+      static_cast<std::size_t>(std::distance(first1,last1))*
+      static_cast<std::size_t>(std::distance(first2,last2)),
+      [&](bool res){
+        f(*res_it1,*res_it2,res);
+        if(++res_it1==last1){
+          res_it1=first1;
+          ++res_it2;
+        }
+      });
+  }
+
   template<typename Iterator>
   void insert_impl(
     Iterator first,Iterator last,std::false_type /* input iterator */)
   {
-    while(first!=last)insert(*first++);
+    buffered_insert([&](std::uint64_t& hash){
+      if(first==last)return false;
+      hash=promoting_hash_for(*first);
+      ++first;
+      return true;
+    });
+  }
+
+  /* Elements of unknown-length sequences are hashed into a buffer that is
+   * fed to bulk_insert when full. next(hash) returns false when the sequence
+   * is exhausted, after which it's not called again.
+   */
+
+  static constexpr std::size_t insert_buffer_size=4*bulk_insert_size;
+
+  template<typename F>
+  void buffered_insert(F next)
+  {
+    std::uint64_t hashes[insert_buffer_size];
+    for(bool done=false;!done;){
+      std::size_t n=0;
+      for(;n<insert_buffer_size;++n){
+        if(!next(hashes[n])){
+          done=true;
+          break;
+        }
+      }
+      const std::uint64_t* p=hashes;
+      super::bulk_insert([&p]{return *p++;},n);
+    }
   }
 
   template<typename Iterator>
@@ -390,6 +510,48 @@ bool operator!=(const filter<T,K,SF,S,H,A>& x,const filter<T,K,SF,S,H,A>& y)
   return !(x==y);
 }
 
+template<typename ForwardIterator,typename U,typename F>
+void multi_may_contain(
+  ForwardIterator first,ForwardIterator last,const U& x,F f)
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+  using filter_type=
+    typename std::iterator_traits<ForwardIterator>::value_type;
+  using super=typename filter_type::super;
+
+  if(first==last)return;
+
+  /* x is hashed only once, as all filters are assumed to have equivalent
+   * hash functions.
+   */
+
+  const std::uint64_t hash=(*first).promoting_hash_for(x);
+  super::bulk_multi_may_contain(
+    [first,hash](std::uint64_t& h)mutable->const super&{
+      h=hash;
+      return *first++;
+    },
+    static_cast<std::size_t>(std::distance(first,last)),
+    [&f,first](bool res)mutable{f(*first++,res);});
+}
+
+template<typename FilterForwardIterator,typename ForwardIterator,typename F>
+void multi_may_contain(
+  FilterForwardIterator first1,FilterForwardIterator last1,
+  ForwardIterator first2,ForwardIterator last2,F f)
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(FilterForwardIterator);
+  BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+  using filter_type=
+    typename std::iterator_traits<FilterForwardIterator>::value_type;
+
+  if(first1==last1)return;
+
+  filter_type::multi_may_contain_impl(
+    first1,last1,first2,last2,f,
+    std::integral_constant<bool,filter_type::k==1>{});
+}
+
 template<
   typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
 >
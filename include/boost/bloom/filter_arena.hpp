@@ -0,0 +1,622 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_FILTER_ARENA_HPP
+#define BOOST_BLOOM_FILTER_ARENA_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/span.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Pool of filters with the same configuration and capacity as
+ * filter<T,K,Subfilter,Stride,Hash>, packed back to back into large
+ * cacheline-aligned slabs rather than allocated one by one. Each filter
+ * slot takes the filter's array size rounded up to the block alignment,
+ * with none of the per-filter padding and allocation overhead of
+ * filter_core. Filters are accessed through handles consisting of a
+ * pointer to the slot and the filter's range; the bit layout and hashing
+ * are those of filter, so a handle's array() is interchangeable with that
+ * of an equivalent filter. Slots of removed filters are kept in a stack
+ * outside the slabs for reuse, so that all filters can be cleared at once
+ * by zeroing whole slabs, or released at once by resetting the slab cursor.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class filter_arena:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(K>0,"K must be >= 1");
+  using core_type=detail::filter_core<K,Subfilter,Stride,Allocator>;
+  using pointer_allocator_type=allocator_rebind_t<Allocator,unsigned char*>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+  using hash_strategy=detail::fastrange_and_mcg;
+  using block_type=typename Subfilter::value_type;
+  static constexpr std::size_t used_value_size=
+    detail::used_value_size<Subfilter>::value;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  using subfilter=Subfilter;
+  static constexpr std::size_t stride=core_type::stride;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t slab_size=64*1024;
+
+private:
+  static constexpr bool are_blocks_aligned=
+    (stride%alignof(block_type)==0);
+  static constexpr std::size_t slot_alignment=
+    are_blocks_aligned?alignof(block_type):1;
+  static constexpr std::size_t cacheline=BOOST_BLOOM_CACHELINE_SIZE;
+
+public:
+  /* Lightweight reference to a filter in the arena. Copies of a handle
+   * refer to the same filter. Handles are invalidated when the filter is
+   * removed or the arena is reset or destroyed.
+   */
+
+  class handle:empty_value<Hash,0>
+  {
+  public:
+    handle()=default;
+
+    std::size_t capacity()const noexcept
+    {
+      return p?used_array_size(hs.range())*CHAR_BIT:0;
+    }
+
+    BOOST_FORCEINLINE void insert(const T& x)
+    {
+      insert_hash(hash_for(x));
+    }
+
+    template<
+      typename U,
+      typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+    >
+    BOOST_FORCEINLINE void insert(const U& x)
+    {
+      insert_hash(hash_for(x));
+    }
+
+    template<typename InputIterator>
+    void insert(InputIterator first,InputIterator last)
+    {
+      for(;first!=last;++first)insert_hash(hash_for(*first));
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+      insert(il.begin(),il.end());
+    }
+
+    void clear()noexcept
+    {
+      if(p)std::memset(p,0,used_array_size(hs.range()));
+    }
+
+    BOOST_FORCEINLINE bool may_contain(const T& x)const
+    {
+      return may_contain_hash(hash_for(x));
+    }
+
+    template<
+      typename U,
+      typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+    >
+    BOOST_FORCEINLINE bool may_contain(const U& x)const
+    {
+      return may_contain_hash(hash_for(x));
+    }
+
+    boost::span<unsigned char> array()const noexcept
+    {
+      return {p,capacity()/CHAR_BIT};
+    }
+
+    hasher hash_function()const
+    {
+      return h();
+    }
+
+  private:
+    friend class filter_arena;
+    using hash_base=empty_value<Hash,0>;
+
+    handle(unsigned char* p_,const hash_strategy& hs_,const Hash& h_):
+      hash_base{empty_init,h_},p{p_},hs{hs_}{}
+
+    const Hash& h()const{return hash_base::get();}
+
+    template<typename U>
+    /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+    inline std::uint64_t hash_for(const U& x)const
+    {
+      return mix_policy::mix(h(),x);
+    }
+
+    /* same sequence of positions as filter_core */
+
+    BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+    {
+      if(!p)return;
+      hs.prepare_hash(hash);
+      for(auto n=k;n--;){
+        auto q=p+hs.next_position(hash)*stride;
+        set(q,hash);
+      }
+    }
+
+    BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+    {
+      if(!p)return true;
+      hs.prepare_hash(hash);
+      for(auto n=k;n--;){
+        auto q=p+hs.next_position(hash)*stride;
+        if(!get(q,hash))return false;
+      }
+      return true;
+    }
+
+    static BOOST_FORCEINLINE bool get(
+      const unsigned char* q,std::uint64_t hash)
+    {
+      return get(q,hash,std::integral_constant<bool,are_blocks_aligned>{});
+    }
+
+    static BOOST_FORCEINLINE bool get(
+      const unsigned char* q,std::uint64_t hash,
+      std::true_type /* blocks aligned */)
+    {
+      return subfilter::check(*reinterpret_cast<const block_type*>(q),hash);
+    }
+
+    static BOOST_FORCEINLINE bool get(
+      const unsigned char* q,std::uint64_t hash,
+      std::false_type /* blocks not aligned */)
+    {
+      block_type x;
+      std::memcpy(&x,q,sizeof(block_type));
+      return subfilter::check(x,hash);
+    }
+
+    static BOOST_FORCEINLINE void set(unsigned char* q,std::uint64_t hash)
+    {
+      set(q,hash,std::integral_constant<bool,are_blocks_aligned>{});
+    }
+
+    static BOOST_FORCEINLINE void set(
+      unsigned char* q,std::uint64_t hash,
+      std::true_type /* blocks aligned */)
+    {
+      subfilter::mark(*reinterpret_cast<block_type*>(q),hash);
+    }
+
+    static BOOST_FORCEINLINE void set(
+      unsigned char* q,std::uint64_t hash,
+      std::false_type /* blocks not aligned */)
+    {
+      block_type x;
+      std::memcpy(&x,q,sizeof(block_type));
+      subfilter::mark(x,hash);
+      std::memcpy(q,&x,sizeof(block_type));
+    }
+
+    unsigned char* p=nullptr;
+    hash_strategy  hs{0};
+  };
+
+  explicit filter_arena(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al},hs{requested_range(m)}{}
+
+  filter_arena(std::size_t m,const allocator_type& al):
+    filter_arena{m,hasher(),al}{}
+
+  filter_arena(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    filter_arena{capacity_for(n,fpr),h,al}{}
+
+  filter_arena(std::size_t n,double fpr,const allocator_type& al):
+    filter_arena{n,fpr,hasher(),al}{}
+
+  /* not copyable, as handles would refer to the original */
+
+  filter_arena(const filter_arena&)=delete;
+  filter_arena& operator=(const filter_arena&)=delete;
+
+  filter_arena(filter_arena&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},al_{std::move(x.al_)},
+    hs{x.hs},size_{x.size_},slabs{x.slabs},last_slab{x.last_slab},
+    cur_slab{x.cur_slab},next_slot{x.next_slot},free_slots{x.free_slots},
+    num_free{x.num_free},free_capacity{x.free_capacity}
+  {
+    x.reset_state();
+  }
+
+  ~filter_arena()noexcept
+  {
+    delete_slabs();
+    delete_free_slots();
+  }
+
+  /* Handles into x remain valid, so memory must be transferable. */
+
+  filter_arena& operator=(filter_arena&& x)noexcept
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      BOOST_ASSERT(pocma||al_==x.al_);
+      delete_slabs();
+      delete_free_slots();
+      detail::move_assign_if<pocma>(al_,x.al_);
+      h()=std::move(x.h());
+      hs=x.hs;
+      size_=x.size_;
+      slabs=x.slabs;
+      last_slab=x.last_slab;
+      cur_slab=x.cur_slab;
+      next_slot=x.next_slot;
+      free_slots=x.free_slots;
+      num_free=x.num_free;
+      free_capacity=x.free_capacity;
+      x.reset_state();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  /* capacity of each filter, same as filter<T,K,Subfilter,Stride>(m) */
+
+  std::size_t capacity()const noexcept
+  {
+    return used_array_size(hs.range())*CHAR_BIT;
+  }
+
+  static std::size_t capacity_for(std::size_t n,double fpr)
+  {
+    return core_type::capacity_for(n,fpr);
+  }
+
+  static double fpr_for(std::size_t n,std::size_t m)
+  {
+    return core_type::fpr_for(n,m);
+  }
+
+  /* number of filters in use */
+
+  std::size_t size()const noexcept
+  {
+    return size_;
+  }
+
+  /* bytes taken by each filter in a slab */
+
+  std::size_t slot_size()const noexcept
+  {
+    std::size_t n=used_array_size(hs.range());
+    return (n+slot_alignment-1)/slot_alignment*slot_alignment;
+  }
+
+  /* number of filters per slab */
+
+  std::size_t slab_capacity()const noexcept
+  {
+    std::size_t s=slot_size();
+    return !s?0:s>=slab_size?1:slab_size/s;
+  }
+
+  std::size_t slab_count()const noexcept
+  {
+    std::size_t n=0;
+    for(auto p=slabs;p;p=next_slab(p))++n;
+    return n;
+  }
+
+  /* allocates slabs as needed for n filters in use */
+
+  void reserve(std::size_t n)
+  {
+    if(!slab_capacity())return;
+    std::size_t available=num_free;
+    if(cur_slab){
+      available+=(std::size_t)(slab_end(cur_slab)-next_slot)/slot_size();
+    }
+    for(auto p=cur_slab?next_slab(cur_slab):slabs;p;p=next_slab(p)){
+      available+=slab_capacity();
+    }
+    while(size_+available<n){
+      append_slab();
+      available+=slab_capacity();
+    }
+  }
+
+  /* Returns a handle to an empty filter, reusing a removed filter's slot
+   * if available.
+   */
+
+  handle add()
+  {
+    unsigned char* p=nullptr;
+    std::size_t    s=slot_size();
+    if(num_free)p=free_slots[--num_free];
+    else if(s){
+      if(!cur_slab||slab_end(cur_slab)-next_slot<(std::ptrdiff_t)s){
+        auto q=cur_slab?next_slab(cur_slab):slabs;
+        if(!q)q=append_slab();
+        cur_slab=q;
+        next_slot=slab_begin(q);
+      }
+      p=next_slot;
+      next_slot+=s;
+    }
+    if(p)std::memset(p,0,s);
+    ++size_;
+    return {p,hs,h()};
+  }
+
+  template<typename InputIterator>
+  handle add(InputIterator first,InputIterator last)
+  {
+    handle x=add();
+    x.insert(first,last);
+    return x;
+  }
+
+  handle add(std::initializer_list<value_type> il)
+  {
+    return add(il.begin(),il.end());
+  }
+
+  /* Returns the slot of x to the arena. x and its copies are invalidated.
+   * Throws only if the stack of free slots needs to grow, in which case
+   * the arena is left unchanged.
+   */
+
+  void remove(const handle& x)
+  {
+    BOOST_ASSERT(size_>0);
+    BOOST_ASSERT(x.hs.range()==hs.range());
+    if(x.p){
+      if(num_free==free_capacity)grow_free_slots();
+      free_slots[num_free++]=x.p;
+    }
+    --size_;
+  }
+
+  /* Clears all the filters in use, slab by slab. */
+
+  void clear()noexcept
+  {
+    for(auto p=slabs;p;p=next_slab(p)){
+      std::memset(slab_begin(p),0,slab_capacity()*slot_size());
+    }
+  }
+
+  /* Removes all filters, keeping the slabs for later reuse. */
+
+  void reset()noexcept
+  {
+    size_=0;
+    cur_slab=nullptr;
+    next_slot=nullptr;
+    num_free=0;
+  }
+
+  void swap(filter_arena& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    BOOST_ASSERT(pocs||al_==x.al_);
+    detail::swap_if<pocs>(al_,x.al_);
+    std::swap(h(),x.h());
+    std::swap(hs,x.hs);
+    std::swap(size_,x.size_);
+    std::swap(slabs,x.slabs);
+    std::swap(last_slab,x.last_slab);
+    std::swap(cur_slab,x.cur_slab);
+    std::swap(next_slot,x.next_slot);
+    std::swap(free_slots,x.free_slots);
+    std::swap(num_free,x.num_free);
+    std::swap(free_capacity,x.free_capacity);
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  /* as in filter_core */
+
+  static std::size_t requested_range(std::size_t m)noexcept
+  {
+    if(m>(used_value_size-stride)*CHAR_BIT){
+      m-=(used_value_size-stride)*CHAR_BIT;
+    }
+    return
+      (std::numeric_limits<std::size_t>::max)()-m>=stride*CHAR_BIT-1?
+      (m+stride*CHAR_BIT-1)/(stride*CHAR_BIT):
+      m/(stride*CHAR_BIT);
+  }
+
+  static std::size_t used_array_size(std::size_t rng)noexcept
+  {
+    return rng?rng*stride+(used_value_size-stride):0;
+  }
+
+  /* A slab is a raw allocation holding the pointer to the next slab
+   * followed by cacheline-aligned slots, plus room for accessing whole
+   * blocks when the subfilter only uses part of them (see used_value_size).
+   */
+
+  static constexpr std::size_t slab_header_size=
+    sizeof(unsigned char*)+cacheline-1;
+  static constexpr std::size_t slab_tail_size=
+    sizeof(block_type)-used_value_size;
+
+  std::size_t slab_allocation_size()const noexcept
+  {
+    return slab_header_size+slab_capacity()*slot_size()+slab_tail_size;
+  }
+
+  static unsigned char* next_slab(unsigned char* p)noexcept
+  {
+    unsigned char* q;
+    std::memcpy(&q,p,sizeof(q));
+    return q;
+  }
+
+  static void set_next_slab(unsigned char* p,unsigned char* q)noexcept
+  {
+    std::memcpy(p,&q,sizeof(q));
+  }
+
+  static unsigned char* slab_begin(unsigned char* p)noexcept
+  {
+    p+=sizeof(unsigned char*);
+    return p+(std::uintptr_t(cacheline)-std::uintptr_t(p))%cacheline;
+  }
+
+  unsigned char* slab_end(unsigned char* p)const noexcept
+  {
+    return slab_begin(p)+slab_capacity()*slot_size();
+  }
+
+  unsigned char* append_slab()
+  {
+    auto p=allocator_allocate(al_,slab_allocation_size());
+    set_next_slab(p,nullptr);
+    if(last_slab)set_next_slab(last_slab,p);
+    else         slabs=p;
+    last_slab=p;
+    return p;
+  }
+
+  void delete_slabs()noexcept
+  {
+    std::size_t n=slab_allocation_size();
+    for(auto p=slabs;p;){
+      auto q=next_slab(p);
+      allocator_deallocate(al_,p,n);
+      p=q;
+    }
+    slabs=last_slab=nullptr;
+  }
+
+  void grow_free_slots()
+  {
+    std::size_t            n=free_capacity?2*free_capacity:16;
+    pointer_allocator_type pal{al_};
+    auto                   p=allocator_allocate(pal,n);
+    if(num_free)std::memcpy(p,free_slots,num_free*sizeof(unsigned char*));
+    delete_free_slots();
+    free_slots=p;
+    free_capacity=n;
+  }
+
+  void delete_free_slots()noexcept
+  {
+    if(free_slots){
+      pointer_allocator_type pal{al_};
+      allocator_deallocate(pal,free_slots,free_capacity);
+      free_slots=nullptr;
+    }
+  }
+
+  void reset_state()noexcept
+  {
+    hs=hash_strategy{0};
+    size_=0;
+    slabs=nullptr;
+    last_slab=nullptr;
+    cur_slab=nullptr;
+    next_slot=nullptr;
+    free_slots=nullptr;
+    num_free=0;
+    free_capacity=0;
+  }
+
+  allocator_type al_;
+  hash_strategy  hs;
+  std::size_t    size_=0;
+  unsigned char* slabs=nullptr;     /* first slab */
+  unsigned char* last_slab=nullptr;
+  unsigned char* cur_slab=nullptr;  /* slab being bump-allocated from */
+  unsigned char* next_slot=nullptr; /* next unused slot of cur_slab */
+  unsigned char** free_slots=nullptr; /* stack of slots of removed filters */
+  std::size_t    num_free=0;
+  std::size_t    free_capacity=0;
+};
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+void swap(filter_arena<T,K,SF,S,H,A>& x,filter_arena<T,K,SF,S,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,661 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_FILTER_BANK_HPP
+#define BOOST_BLOOM_FILTER_BANK_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/bit_rows.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Bank of classical Bloom filters (members) of the same capacity m and
+ * number of hash functions K, stored transposed as in bit-sliced
+ * signatures (BitFunnel, Goodwin et al., 2017): row r holds bit r of all
+ * members, one bit per member slot. Looking up an element in the entire
+ * bank amounts to ANDing its K rows, which yields the bitmap of members
+ * that may contain it; rows are traversed sequentially one cacheline at a
+ * time with SIMD, and traversal of a chunk stops as soon as its partial
+ * result is zero. Member slots are tracked in an extra row; removing a
+ * member clears its column so that it can be reused by a later addition,
+ * and removing several members at once takes a single pass over the rows.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class filter_bank:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(K>0,"K must be >= 1");
+  using mix_policy=detail::mix_policy_for<Hash>;
+  using word_allocator_type=allocator_rebind_t<Allocator,std::uint64_t>;
+  using hash_strategy=detail::fastrange_and_mcg;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=16;
+
+  explicit filter_bank(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al},hs{m}{}
+
+  filter_bank(std::size_t m,const allocator_type& al):
+    filter_bank{m,hasher(),al}{}
+
+  filter_bank(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    filter_bank{capacity_for(n,fpr),h,al}{}
+
+  filter_bank(std::size_t n,double fpr,const allocator_type& al):
+    filter_bank{n,fpr,hasher(),al}{}
+
+  filter_bank(const filter_bank& x):
+    filter_bank{x,allocator_select_on_container_copy_construction(x.al_)}{}
+
+  filter_bank(filter_bank&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},al_{std::move(x.al_)},
+    hs{x.hs},row_words{x.row_words},size_{x.size_},free_hint{x.free_hint},
+    data{x.data},array{x.array}
+  {
+    x.reset_state();
+  }
+
+  filter_bank(const filter_bank& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},al_{al},hs{x.hs}
+  {
+    copy_state(x);
+  }
+
+  ~filter_bank()noexcept
+  {
+    delete_words();
+  }
+
+  filter_bank& operator=(const filter_bank& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      delete_words();
+      reset_state();
+      detail::copy_assign_if<pocca>(al_,x.al_);
+      h()=x.h();
+      hs=x.hs;
+      copy_state(x);
+    }
+    return *this;
+  }
+
+  filter_bank& operator=(filter_bank&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al_==x.al_){
+        delete_words();
+        detail::move_assign_if<pocma>(al_,x.al_);
+        h()=std::move(x.h());
+        hs=x.hs;
+        row_words=x.row_words;
+        size_=x.size_;
+        free_hint=x.free_hint;
+        data=x.data;
+        array=x.array;
+        x.reset_state();
+      }
+      else *this=static_cast<const filter_bank&>(x);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  /* number of bits of each member */
+
+  std::size_t capacity()const noexcept
+  {
+    return hs.range();
+  }
+
+  /* number of members */
+
+  std::size_t size()const noexcept
+  {
+    return size_;
+  }
+
+  /* number of member slots allocated */
+
+  std::size_t member_capacity()const noexcept
+  {
+    return row_words*64;
+  }
+
+  /* Classical Bloom filter formulas for a member with capacity m and n
+   * elements inserted.
+   */
+
+  static std::size_t capacity_for(std::size_t n,double fpr)
+  {
+    if(!(fpr>0.0&&fpr<=1.0)){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("fpr must be in (0,1]"));
+    }
+    if(n==0||fpr==1.0)return 0;
+    double m=std::ceil(
+      -(double)(k*n)/std::log(1.0-std::pow(fpr,1.0/(double)k)));
+    return (std::size_t)m;
+  }
+
+  static double fpr_for(std::size_t n,std::size_t m)
+  {
+    if(m==0)return 1.0;
+    return std::pow(1.0-std::exp(-(double)(k*n)/(double)m),(double)k);
+  }
+
+  void reserve(std::size_t n)
+  {
+    if(n>member_capacity())grow(n);
+  }
+
+  bool is_member(size_type i)const noexcept
+  {
+    return i<member_capacity()&&(live_row()[i/64]>>(i%64))&1;
+  }
+
+  /* Adds an empty member and returns its index, which is the lowest
+   * index not in use.
+   */
+
+  size_type add()
+  {
+    if(size_==member_capacity())grow(size_+1);
+    std::uint64_t* live=live_row();
+    while(live[free_hint]==~std::uint64_t(0))++free_hint;
+    size_type i=free_hint*64+
+      (size_type)boost::core::countr_zero(~live[free_hint]);
+    live[i/64]|=std::uint64_t(1)<<(i%64);
+    ++size_;
+    return i;
+  }
+
+  template<typename InputIterator>
+  size_type add(InputIterator first,InputIterator last)
+  {
+    size_type i=add();
+    insert(i,first,last);
+    return i;
+  }
+
+  size_type add(std::initializer_list<value_type> il)
+  {
+    return add(il.begin(),il.end());
+  }
+
+  /* Adds n empty members and writes their indices to res. */
+
+  template<typename OutputIterator>
+  OutputIterator add(std::size_t n,OutputIterator res)
+  {
+    reserve(size_+n);
+    while(n--)*res++=add();
+    return res;
+  }
+
+  void remove(size_type i)noexcept
+  {
+    BOOST_ASSERT(is_member(i));
+    std::size_t   w=i/64;
+    std::uint64_t mask=~(std::uint64_t(1)<<(i%64));
+    for(std::size_t r=0;r<=capacity();++r)array[r*row_words+w]&=mask;
+    --size_;
+    if(w<free_hint)free_hint=w;
+  }
+
+  /* Removes the members with the indices in [first,last) by building a
+   * mask of their columns and clearing it from each row in one pass.
+   */
+
+  template<typename InputIterator>
+  void remove(InputIterator first,InputIterator last)
+  {
+    if(first==last)return;
+
+    detail::temporary_buffer<std::uint64_t,allocator_type> buf{
+      al_,row_words};
+    std::uint64_t* mask=buf.data();
+    std::memset(mask,0,row_words*8);
+    std::size_t    lo=row_words,hi=0;
+    for(;first!=last;++first){
+      size_type i=*first;
+      BOOST_ASSERT(is_member(i));
+      mask[i/64]|=std::uint64_t(1)<<(i%64);
+      if(i/64<lo)lo=i/64;
+      if(i/64>=hi)hi=i/64+1;
+    }
+    std::uint64_t* live=live_row();
+    for(std::size_t w=lo;w<hi;++w){
+      size_-=(std::size_t)boost::core::popcount(live[w]&mask[w]);
+      mask[w]=~mask[w];
+    }
+    for(std::size_t r=0;r<=capacity();++r){
+      std::uint64_t* p=array+r*row_words;
+      for(std::size_t w=lo;w<hi;++w)p[w]&=mask[w];
+    }
+    if(lo<free_hint)free_hint=lo;
+  }
+
+  void remove(std::initializer_list<size_type> il)
+  {
+    remove(il.begin(),il.end());
+  }
+
+  BOOST_FORCEINLINE void insert(size_type i,const T& x)
+  {
+    insert_hash(i,hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(size_type i,const U& x)
+  {
+    insert_hash(i,hash_for(x));
+  }
+
+  /* The rows of the next bulk_insert_size elements are prefetched before
+   * they are updated.
+   */
+
+  template<typename InputIterator>
+  void insert(size_type i,InputIterator first,InputIterator last)
+  {
+    BOOST_ASSERT(is_member(i));
+    if(!capacity()){
+      for(;first!=last;++first){}
+      return;
+    }
+
+    std::uint64_t hashes[bulk_insert_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<bulk_insert_size&&first!=last;++first,++n){
+        hashes[n]=hash_for(*first);
+        for_each_row(hashes[n],[&](std::size_t r){
+          BOOST_BLOOM_PREFETCH_WRITE(array+r*row_words+i/64);
+        });
+      }
+      for(std::size_t j=0;j<n;++j)set(i,hashes[j]);
+    }
+  }
+
+  void insert(size_type i,std::initializer_list<value_type> il)
+  {
+    insert(i,il.begin(),il.end());
+  }
+
+  /* Removes all members. */
+
+  void clear()noexcept
+  {
+    if(data)std::memset(array,0,(capacity()+1)*row_words*8);
+    size_=0;
+    free_hint=0;
+  }
+
+  void swap(filter_bank& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    BOOST_ASSERT(pocs||al_==x.al_);
+    detail::swap_if<pocs>(al_,x.al_);
+    std::swap(h(),x.h());
+    std::swap(hs,x.hs);
+    std::swap(row_words,x.row_words);
+    std::swap(size_,x.size_);
+    std::swap(free_hint,x.free_hint);
+    std::swap(data,x.data);
+    std::swap(array,x.array);
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(size_type i,const T& x)const
+  {
+    return may_contain_hash(i,hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(size_type i,const U& x)const
+  {
+    return may_contain_hash(i,hash_for(x));
+  }
+
+  /* Calls f(i) in ascending order for each member i that may contain x. */
+
+  template<typename F>
+  void match(const T& x,F f)const
+  {
+    match_hash(hash_for(x),f);
+  }
+
+  template<
+    typename U,typename F,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  void match(const U& x,F f)const
+  {
+    match_hash(hash_for(x),f);
+  }
+
+  /* Calls f(i) in ascending order for each member i that may contain all
+   * the elements in [first,last), ANDing the rows of all of them at once.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void match_all(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    if(!size_)return;
+    std::size_t n=capacity()?
+      (std::size_t)std::distance(first,last)*k:0;
+    detail::temporary_buffer<const std::uint64_t*,allocator_type> buf{
+      al_,n+1};
+    const std::uint64_t** rows=buf.data();
+    std::size_t           num_rows=0;
+    if(n){
+      for(;first!=last;++first){
+        for_each_row(hash_for(*first),[&](std::size_t r){
+          rows[num_rows++]=array+r*row_words;
+        });
+      }
+    }
+    else rows[num_rows++]=live_row();
+    match_rows(rows,num_rows,f);
+  }
+
+  template<typename F>
+  void match_all(std::initializer_list<value_type> il,F f)const
+  {
+    match_all(il.begin(),il.end(),f);
+  }
+
+  /* Two banks are equal if they have the same capacity and members, and
+   * each member has the same bits in both.
+   */
+
+  friend bool operator==(const filter_bank& x,const filter_bank& y)
+  {
+    if(x.capacity()!=y.capacity()||x.size_!=y.size_)return false;
+    const filter_bank& a=x.row_words<y.row_words?x:y;
+    const filter_bank& b=x.row_words<y.row_words?y:x;
+    for(std::size_t r=0;r<=a.capacity();++r){
+      const std::uint64_t* p=a.array+r*a.row_words;
+      const std::uint64_t* q=b.array+r*b.row_words;
+      if(a.row_words&&std::memcmp(p,q,a.row_words*8)!=0)return false;
+      for(std::size_t w=a.row_words;w<b.row_words;++w){
+        if(q[w])return false;
+      }
+    }
+    return true;
+  }
+
+  friend bool operator!=(const filter_bank& x,const filter_bank& y)
+  {
+    return !(x==y);
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+  static constexpr std::size_t chunk_words=detail::bit_rows_chunk_words;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  /* rows are cacheline-aligned, hence the extra chunk_words-1 words */
+
+  static std::size_t num_words(
+    std::size_t rows,std::size_t words_per_row)noexcept
+  {
+    return words_per_row?rows*words_per_row+chunk_words-1:0;
+  }
+
+  std::size_t num_words()const noexcept
+  {
+    return num_words(capacity()+1,row_words);
+  }
+
+  const std::uint64_t* live_row()const noexcept
+  {
+    return array+capacity()*row_words;
+  }
+
+  std::uint64_t* live_row()noexcept
+  {
+    return array+capacity()*row_words;
+  }
+
+  /* calls f(r) for each of the k rows of the element */
+
+  template<typename F>
+  BOOST_FORCEINLINE void for_each_row(std::uint64_t hash,F f)const
+  {
+    hs.prepare_hash(hash);
+    for(std::size_t j=0;j<k;++j)f(hs.next_position(hash));
+  }
+
+  BOOST_FORCEINLINE void set(size_type i,std::uint64_t hash)
+  {
+    std::uint64_t bit=std::uint64_t(1)<<(i%64);
+    for_each_row(hash,[&](std::size_t r){
+      array[r*row_words+i/64]|=bit;
+    });
+  }
+
+  BOOST_FORCEINLINE void insert_hash(size_type i,std::uint64_t hash)
+  {
+    BOOST_ASSERT(is_member(i));
+    if(capacity())set(i,hash);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(
+    size_type i,std::uint64_t hash)const
+  {
+    BOOST_ASSERT(is_member(i));
+    if(!capacity())return true;
+    std::uint64_t res=1;
+    for_each_row(hash,[&](std::size_t r){
+      res&=array[r*row_words+i/64]>>(i%64);
+    });
+    return res!=0;
+  }
+
+  template<typename F>
+  void match_hash(std::uint64_t hash,F& f)const
+  {
+    if(!size_)return;
+    const std::uint64_t* rows[k];
+    std::size_t          num_rows=0;
+    if(capacity()){
+      for_each_row(hash,[&](std::size_t r){
+        rows[num_rows++]=array+r*row_words;
+      });
+    }
+    else rows[num_rows++]=live_row();
+    match_rows(rows,num_rows,f);
+  }
+
+  /* members not in use have all-zero columns, so the live row need only be
+   * considered if there are no other rows.
+   */
+
+  template<typename F>
+  void match_rows(
+    const std::uint64_t* const* rows,std::size_t num_rows,F& f)const
+  {
+    std::uint64_t res[chunk_words];
+    for(std::size_t off=0;off<row_words;off+=chunk_words){
+      if(!detail::and_rows(rows,num_rows,off,res))continue;
+      for(std::size_t j=0;j<chunk_words;++j){
+        for(std::uint64_t w=res[j];w;w&=w-1){
+          f((off+j)*64+(size_type)boost::core::countr_zero(w));
+        }
+      }
+    }
+  }
+
+  /* Reallocates to make room for at least n members, doubling the number
+   * of slots at least, and copies rows over.
+   */
+
+  void grow(std::size_t n)
+  {
+    std::size_t new_row_words=row_words*2;
+    if(new_row_words<(n+63)/64)new_row_words=(n+63)/64;
+    new_row_words=(new_row_words+chunk_words-1)/chunk_words*chunk_words;
+
+    std::size_t         rows=capacity()+1,
+                        n_words=num_words(rows,new_row_words);
+    word_allocator_type wal{al_};
+    std::uint64_t*      new_data=allocator_allocate(wal,n_words);
+    std::uint64_t*      new_array=align(new_data);
+    std::memset(new_array,0,rows*new_row_words*8);
+    for(std::size_t r=0;r<rows&&row_words;++r){
+      std::memcpy(
+        new_array+r*new_row_words,array+r*row_words,row_words*8);
+    }
+    delete_words();
+    row_words=new_row_words;
+    data=new_data;
+    array=new_array;
+  }
+
+  static std::uint64_t* align(std::uint64_t* p)noexcept
+  {
+    auto addr=reinterpret_cast<std::uintptr_t>(p);
+    return p+(((chunk_words*8)-addr%(chunk_words*8))%(chunk_words*8))/8;
+  }
+
+  void copy_state(const filter_bank& x)
+  {
+    if(x.data){
+      word_allocator_type wal{al_};
+      std::size_t         n_words=num_words(x.capacity()+1,x.row_words);
+      data=allocator_allocate(wal,n_words);
+      array=align(data);
+      std::memcpy(array,x.array,(x.capacity()+1)*x.row_words*8);
+    }
+    row_words=x.row_words;
+    size_=x.size_;
+    free_hint=x.free_hint;
+  }
+
+  void reset_state()noexcept
+  {
+    hs=hash_strategy{0};
+    row_words=0;
+    size_=0;
+    free_hint=0;
+    data=nullptr;
+    array=nullptr;
+  }
+
+  void delete_words()noexcept
+  {
+    if(data){
+      word_allocator_type wal{al_};
+      allocator_deallocate(wal,data,num_words());
+      data=nullptr;
+    }
+  }
+
+  allocator_type al_;
+  hash_strategy  hs;
+  std::size_t    row_words=0;
+  std::size_t    size_=0;
+  std::size_t    free_hint=0; /* words of the live row before it are full */
+  std::uint64_t* data=nullptr;
+  std::uint64_t* array=nullptr; /* adjusted from data for alignment */
+};
+
+template<typename T,std::size_t K,typename Hash,typename Allocator>
+void swap(
+  filter_bank<T,K,Hash,Allocator>& x,filter_bank<T,K,Hash,Allocator>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
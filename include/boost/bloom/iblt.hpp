@@ -0,0 +1,468 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_IBLT_HPP
+#define BOOST_BLOOM_IBLT_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_trivially_copyable.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Invertible Bloom lookup table (Goodrich and Mitzenmacher, 2011) for set
+ * reconciliation (Eppstein et al., 2011). Each element is added to one cell
+ * in each of K equally sized subtables, selected as in filter_core; a cell
+ * keeps the number of elements added minus those removed, the xor of their
+ * bits and the xor of their check hashes. Subtracting the table of set B
+ * from that of set A leaves only the elements of the symmetric difference,
+ * which can be listed by repeatedly peeling pure cells (those holding a
+ * single element, with count +1 or -1 and a matching check hash) as long
+ * as the difference is not much larger than the size the table was
+ * created for.
+ *
+ * Cell fields are laid out as three separate arrays (counts, check hashes
+ * and element bits) so that subtraction reduces to two linear loops.
+ */
+
+template<
+  typename T,std::size_t K=4,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class iblt:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    boost::is_trivially_copyable<T>::value,"T must be trivially copyable");
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(K>=3&&K<=8,"K must be in [3,8]");
+  using mix_policy=detail::mix_policy_for<Hash>;
+  using word_allocator_type=allocator_rebind_t<Allocator,std::uint64_t>;
+  using hash_strategy=detail::fastrange_and_mcg;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_operation_size=16;
+
+  explicit iblt(
+    std::size_t d=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al},hs{cell_count_for(d)/k}
+  {
+    allocate_words();
+  }
+
+  iblt(std::size_t d,const allocator_type& al):iblt{d,hasher(),al}{}
+
+  template<typename InputIterator>
+  iblt(
+    InputIterator first,InputIterator last,std::size_t d,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    iblt{d,h,al}
+  {
+    insert(first,last);
+  }
+
+  iblt(
+    std::initializer_list<value_type> il,std::size_t d,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    iblt{il.begin(),il.end(),d,h,al}{}
+
+  iblt(const iblt& x):
+    iblt{x,allocator_select_on_container_copy_construction(x.al_)}{}
+
+  iblt(iblt&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},al_{std::move(x.al_)},
+    hs{x.hs},words{x.words}
+  {
+    x.hs=hash_strategy{0};
+    x.words=nullptr;
+  }
+
+  iblt(const iblt& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},al_{al},hs{x.hs}
+  {
+    allocate_words();
+    copy_words(x);
+  }
+
+  ~iblt()noexcept
+  {
+    delete_words();
+  }
+
+  iblt& operator=(const iblt& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      delete_words();
+      detail::copy_assign_if<pocca>(al_,x.al_);
+      h()=x.h();
+      hs=x.hs;
+      allocate_words();
+      copy_words(x);
+    }
+    return *this;
+  }
+
+  iblt& operator=(iblt&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al_==x.al_){
+        delete_words();
+        detail::move_assign_if<pocma>(al_,x.al_);
+        h()=std::move(x.h());
+        hs=x.hs;
+        words=x.words;
+        x.hs=hash_strategy{0};
+        x.words=nullptr;
+      }
+      else *this=static_cast<const iblt&>(x);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  /* Number of cells for decoding a difference of d elements with high
+   * probability: 10% above the peeling threshold for K subtables (1.30*d
+   * for K=4) plus O(sqrt(d)) slack, as small tables fall short of the
+   * asymptotic threshold.
+   */
+
+  static std::size_t cell_count_for(std::size_t d)
+  {
+    static constexpr double thresholds[]={
+      1.222,1.295,1.425,1.570,1.721,1.872};
+
+    if(d==0)return 0;
+    double c=(double)d*thresholds[K-3]*1.1+(double)K*(4.0+2.0*std::sqrt((double)d));
+    if(c>=(double)(max_cells()-K)){
+      BOOST_THROW_EXCEPTION(std::length_error("difference too large"));
+    }
+    std::size_t n=(std::size_t)c;
+    return (n+K-1)/K*K;
+  }
+
+  std::size_t cell_count()const noexcept
+  {
+    return num_cells();
+  }
+
+  /* number of bits used */
+
+  std::size_t capacity()const noexcept
+  {
+    return num_words()*64;
+  }
+
+  void insert(const T& x)
+  {
+    update(hash_for(x),x,1);
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    bulk_update(first,last,1);
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void erase(const T& x)
+  {
+    update(hash_for(x),x,std::uint64_t(-1));
+  }
+
+  template<typename InputIterator>
+  void erase(InputIterator first,InputIterator last)
+  {
+    bulk_update(first,last,std::uint64_t(-1));
+  }
+
+  /* Cell-wise subtraction: afterwards, *this encodes the elements of the
+   * original *this not in x with count +1 and those of x not in *this
+   * with count -1.
+   */
+
+  iblt& operator-=(const iblt& x)
+  {
+    if(num_cells()!=x.num_cells()){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible tables"));
+    }
+    std::size_t          n=num_cells();
+    std::uint64_t*       p=words;
+    const std::uint64_t* q=x.words;
+    for(std::size_t i=0;i<n;++i)p[i]-=q[i];
+    for(std::size_t i=n;i<num_words();++i)p[i]^=q[i];
+    return *this;
+  }
+
+  /* Lists the elements encoded with count +1 into positive and those with
+   * count -1 into negative. Returns true if the table could be fully
+   * decoded, false otherwise (in which case only part of the elements
+   * have been listed). Peeling is done on a temporary copy of the table.
+   */
+
+  template<typename OutputIterator1,typename OutputIterator2>
+  bool decode(OutputIterator1 positive,OutputIterator2 negative)const
+  {
+    std::size_t n=num_cells();
+    if(n==0)return true;
+
+    detail::temporary_buffer<std::uint64_t,allocator_type> buf{
+      al_,num_words()};
+    auto p=buf.data();
+    std::memcpy(p,words,num_words()*8);
+
+    std::size_t peeled=0;
+    for(bool progress=true;progress;){
+      progress=false;
+      for(std::size_t i=0;i<n;++i){
+        std::uint64_t c=p[i];
+        if(c!=1&&c!=std::uint64_t(-1))continue;
+        T      x;
+        auto   hash=hash_for(load(x,p+2*n+i*key_words));
+        if(p[n+i]!=check_hash(hash))continue;
+
+        /* a legit table can't be peeled more than n times */
+
+        if(++peeled>n)return false;
+        if(c==1)*positive++=x;
+        else    *negative++=x;
+        update(p,hash,x,std::uint64_t(0)-c);
+        progress=true;
+      }
+    }
+    for(std::size_t i=0;i<num_words();++i){
+      if(p[i])return false;
+    }
+    return true;
+  }
+
+  void swap(iblt& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    BOOST_ASSERT(pocs||al_==x.al_);
+    detail::swap_if<pocs>(al_,x.al_);
+    std::swap(h(),x.h());
+    std::swap(hs,x.hs);
+    std::swap(words,x.words);
+  }
+
+  void clear()noexcept
+  {
+    if(words)std::memset(words,0,num_words()*8);
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  friend bool operator==(const iblt& x,const iblt& y)
+  {
+    return
+      x.num_cells()==y.num_cells()&&
+      (!x.words||std::memcmp(x.words,y.words,x.num_words()*8)==0);
+  }
+
+  friend bool operator!=(const iblt& x,const iblt& y)
+  {
+    return !(x==y);
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  /* words: counts[n], check hashes[n], element bits[n*key_words] */
+
+  static constexpr std::size_t key_words=(sizeof(T)+7)/8;
+  static constexpr std::size_t cell_words=2+key_words;
+
+  static constexpr std::size_t max_cells()noexcept
+  {
+    return (std::size_t(-1))/(cell_words*8);
+  }
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  static std::uint64_t check_hash(std::uint64_t hash)noexcept
+  {
+    return detail::mulx64(hash^0x9E3779B97F4A7C15ull);
+  }
+
+  static const T& load(T& x,const std::uint64_t* p)noexcept
+  {
+    std::memcpy(&x,p,sizeof(T));
+    return x;
+  }
+
+  std::size_t num_cells()const noexcept
+  {
+    return hs.range()*k;
+  }
+
+  std::size_t num_words()const noexcept
+  {
+    return num_cells()*cell_words;
+  }
+
+  BOOST_FORCEINLINE void prefetch(std::uint64_t hash)const noexcept
+  {
+    std::size_t n=num_cells();
+    hs.prepare_hash(hash);
+    for(std::size_t i=0;i<k;++i){
+      auto pos=hs.range()*i+hs.next_position(hash);
+      BOOST_BLOOM_PREFETCH((const unsigned char*)(words+pos));
+      BOOST_BLOOM_PREFETCH((const unsigned char*)(words+n+pos));
+      BOOST_BLOOM_PREFETCH(
+        (const unsigned char*)(words+2*n+pos*key_words));
+    }
+  }
+
+  BOOST_FORCEINLINE void update(
+    std::uint64_t hash,const T& x,std::uint64_t c)noexcept
+  {
+    if(words)update(words,hash,x,c);
+  }
+
+  void update(
+    std::uint64_t* p,std::uint64_t hash,const T& x,std::uint64_t c)
+    const noexcept
+  {
+    std::uint64_t key[key_words]={};
+    std::memcpy(key,&x,sizeof(T));
+
+    std::size_t   n=num_cells();
+    std::uint64_t check=check_hash(hash);
+    hs.prepare_hash(hash);
+    for(std::size_t i=0;i<k;++i){
+      auto pos=hs.range()*i+hs.next_position(hash);
+      p[pos]+=c;
+      p[n+pos]^=check;
+      for(std::size_t j=0;j<key_words;++j)p[2*n+pos*key_words+j]^=key[j];
+    }
+  }
+
+  template<typename InputIterator>
+  void bulk_update(InputIterator first,InputIterator last,std::uint64_t c)
+  {
+    if(!words){
+      for(;first!=last;++first){}
+      return;
+    }
+
+    std::uint64_t hashes[bulk_operation_size];
+    T             xs[bulk_operation_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<bulk_operation_size&&first!=last;++first,++n){
+        xs[n]=*first;
+        hashes[n]=hash_for(xs[n]);
+        prefetch(hashes[n]);
+      }
+      for(std::size_t i=0;i<n;++i)update(words,hashes[i],xs[i],c);
+    }
+  }
+
+  void allocate_words()
+  {
+    if(num_words()){
+      word_allocator_type wal{al_};
+      words=allocator_allocate(wal,num_words());
+      std::memset(words,0,num_words()*8);
+    }
+  }
+
+  void delete_words()noexcept
+  {
+    if(words){
+      word_allocator_type wal{al_};
+      allocator_deallocate(wal,words,num_words());
+      words=nullptr;
+    }
+  }
+
+  void copy_words(const iblt& x)noexcept
+  {
+    if(words)std::memcpy(words,x.words,num_words()*8);
+  }
+
+  allocator_type al_;
+  hash_strategy  hs;
+  std::uint64_t* words=nullptr;
+};
+
+template<typename T,std::size_t K,typename Hash,typename Allocator>
+void swap(iblt<T,K,Hash,Allocator>& x,iblt<T,K,Hash,Allocator>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
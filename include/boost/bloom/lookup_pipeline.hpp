@@ -0,0 +1,117 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_LOOKUP_PIPELINE_HPP
+#define BOOST_BLOOM_LOOKUP_PIPELINE_HPP
+
+#include <boost/config.hpp>
+#include <boost/core/empty_value.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* lookup_pipeline accepts lookups one at a time and keeps up to depth of
+ * them pending, with their first memory position already prefetched. When
+ * the pipeline is full, submitting a new lookup completes the oldest one and
+ * passes its result to the handler along with the token provided at
+ * submission time. This gives lookups coming from unrelated call sites
+ * (request handlers, coroutines, etc.) much the same memory-level
+ * parallelism as bulk may_contain.
+ */
+
+template<typename Filter,typename Token,typename Handler>
+class lookup_pipeline:empty_value<Handler,0>
+{
+  using super=typename Filter::super;
+  using handler_base=empty_value<Handler,0>;
+
+public:
+  using filter_type=Filter;
+  using token_type=Token;
+  using handler_type=Handler;
+
+  static constexpr std::size_t depth=super::pipelined_may_contain_size;
+
+  explicit lookup_pipeline(
+    const filter_type& f_,const handler_type& h_=handler_type()):
+    handler_base{empty_init,h_},f{f_}{}
+
+  lookup_pipeline(const lookup_pipeline&)=delete;
+  lookup_pipeline& operator=(const lookup_pipeline&)=delete;
+
+  ~lookup_pipeline(){flush();}
+
+  const filter_type& filter()const noexcept{return f;}
+  const handler_type& handler()const noexcept{return h();}
+  handler_type& handler()noexcept{return h();}
+
+  std::size_t size()const noexcept{return n;}
+  bool empty()const noexcept{return n==0;}
+
+  template<typename U>
+  BOOST_FORCEINLINE void may_contain(const U& x,const token_type& t)
+  {
+    /* loop rather than if because the handler can submit new lookups */
+
+    while(n==depth)complete_one();
+    auto i=first+n;
+    if(i>=depth)i-=depth;
+    std::uint64_t hash=f.promoting_hash_for(x);
+    positions[i]=core().start_may_contain(hash);
+    hashes[i]=hash;
+    tokens[i]=t;
+    ++n;
+  }
+
+  void flush()
+  {
+    while(n)complete_one();
+  }
+
+private:
+  const super& core()const noexcept{return f;}
+  const handler_type& h()const noexcept{return handler_base::get();}
+  handler_type& h()noexcept{return handler_base::get();}
+
+  BOOST_FORCEINLINE void complete_one()
+  {
+    /* Slot is freed before invoking the handler, which can then
+     * reentrantly submit new lookups.
+     */
+
+    auto i=first;
+    if(++first==depth)first=0;
+    --n;
+    bool  res=core().finish_may_contain(positions[i],hashes[i]);
+    Token t=std::move(tokens[i]);
+    h()(std::move(t),res);
+  }
+
+  const filter_type&   f;
+  std::size_t          first=0,
+                       n=0;
+  std::uint64_t        hashes[depth];
+  const unsigned char* positions[depth];
+  token_type           tokens[depth];
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
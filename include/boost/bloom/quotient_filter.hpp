@@ -0,0 +1,653 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_QUOTIENT_FILTER_HPP
+#define BOOST_BLOOM_QUOTIENT_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/quotient_table.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Counting quotient filter with the rank-and-select slot layout of Pandey
+ * et al. (2017). Each element is reduced to an F-bit fingerprint whose q
+ * high bits select a home slot among 2^q and whose remaining bits are
+ * stored in the table (see detail::quotient_table). F is fixed at
+ * construction time to max(q,MaxQuotientBits)+Bits, so that the table can
+ * grow up to 2^MaxQuotientBits slots while keeping at least Bits remainder
+ * bits. Multiplicities are stored as variable-length counters after each
+ * remainder, so erasure and counting are exact with respect to
+ * fingerprints and a fingerprint inserted c times takes O(log c) slots.
+ *
+ * As fingerprints are stored in sorted order, the table can be rebuilt
+ * with a single sequential pass over its contents: resizing moves one bit
+ * from the remainder into the quotient (doubling the slots and the FPR),
+ * and merging combines the fingerprint sequences of two filters.
+ */
+
+template<
+  typename T,std::size_t Bits=8,std::size_t MaxQuotientBits=20,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class quotient_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(Bits>0&&Bits<=32,"Bits must be in [1,32]");
+  static_assert(
+    MaxQuotientBits>=6&&MaxQuotientBits<=32,
+    "MaxQuotientBits must be in [6,32]");
+  using mix_policy=detail::mix_policy_for<Hash>;
+  using word_allocator_type=allocator_rebind_t<Allocator,std::uint64_t>;
+  using table_type=detail::quotient_table;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t bits=Bits;
+  static constexpr std::size_t max_quotient_bits=MaxQuotientBits;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_operation_size=16;
+
+  explicit quotient_filter(
+    std::size_t n=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al}
+  {
+    std::size_t q=min_quotient_bits;
+    while(max_size_for(q)<n&&q+Bits<64)++q;
+    t.qbits=q;
+    t.rbits=(q>MaxQuotientBits?q:MaxQuotientBits)+Bits-q;
+  }
+
+  template<typename InputIterator>
+  quotient_filter(
+    InputIterator first,InputIterator last,std::size_t n=0,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    quotient_filter{n,h,al}
+  {
+    if(!insert(first,last)){
+      BOOST_THROW_EXCEPTION(std::length_error("quotient_filter is full"));
+    }
+  }
+
+  quotient_filter(
+    std::initializer_list<value_type> il,std::size_t n=0,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    quotient_filter{il.begin(),il.end(),n,h,al}{}
+
+  quotient_filter(std::size_t n,const allocator_type& al):
+    quotient_filter{n,hasher(),al}{}
+
+  quotient_filter(const quotient_filter& x):
+    quotient_filter{
+      x,allocator_select_on_container_copy_construction(x.al_)}{}
+
+  quotient_filter(quotient_filter&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},al_{std::move(x.al_)},
+    t(x.t),size_{x.size_}
+  {
+    x.t.words=nullptr;
+    x.t.num_blocks=x.t.used=x.t.distinct=x.size_=0;
+  }
+
+  quotient_filter(const quotient_filter& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},al_{al}
+  {
+    copy_table(x);
+  }
+
+  ~quotient_filter()noexcept
+  {
+    delete_table(t);
+  }
+
+  quotient_filter& operator=(const quotient_filter& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      delete_table(t);
+      size_=0;
+      detail::copy_assign_if<pocca>(al_,x.al_);
+      h()=x.h();
+      copy_table(x);
+    }
+    return *this;
+  }
+
+  quotient_filter& operator=(quotient_filter&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al_==x.al_){
+        delete_table(t);
+        detail::move_assign_if<pocma>(al_,x.al_);
+        h()=std::move(x.h());
+        t=x.t;
+        size_=x.size_;
+        x.t.words=nullptr;
+        x.t.num_blocks=x.t.used=x.t.distinct=x.size_=0;
+      }
+      else *this=static_cast<const quotient_filter&>(x);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  /* number of bits used by the slot table */
+
+  std::size_t capacity()const noexcept
+  {
+    return t.num_words()*64;
+  }
+
+  /* number of elements inserted and not erased */
+
+  std::size_t size()const noexcept
+  {
+    return size_;
+  }
+
+  bool empty()const noexcept
+  {
+    return size_==0;
+  }
+
+  std::size_t slot_count()const noexcept
+  {
+    return std::size_t(1)<<t.qbits;
+  }
+
+  std::size_t remainder_bits()const noexcept
+  {
+    return t.rbits;
+  }
+
+  std::size_t fingerprint_bits()const noexcept
+  {
+    return t.qbits+t.rbits;
+  }
+
+  /* approximate probability that a lookup for an element not in the
+   * filter succeeds
+   */
+
+  double fpr()const noexcept
+  {
+    return std::ldexp(
+      (double)t.distinct/(double)slot_count(),-(int)t.rbits);
+  }
+
+  void swap(quotient_filter& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    BOOST_ASSERT(pocs||al_==x.al_);
+    detail::swap_if<pocs>(al_,x.al_);
+    std::swap(h(),x.h());
+    std::swap(t,x.t);
+    std::swap(size_,x.size_);
+  }
+
+  void clear()noexcept
+  {
+    if(t.words)std::memset(t.words,0,t.num_words()*8);
+    t.used=t.distinct=size_=0;
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  /* Grows the table automatically when the load factor would exceed 90%
+   * (see resize) as long as more than Bits remainder bits are left. Past
+   * that point, insertion proceeds in the existing table and returns false
+   * (leaving the filter unchanged) when no free slot is found.
+   */
+
+  bool insert(const T& x)
+  {
+    return insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  bool insert(const U& x)
+  {
+    return insert_hash(hash_for(x));
+  }
+
+  /* returns false if some element could not be inserted */
+
+  template<typename InputIterator>
+  bool insert(InputIterator first,InputIterator last)
+  {
+    bool res=true;
+    bulk_apply(first,last,[&,this](std::uint64_t hash){
+      if(!insert_hash(hash))res=false;
+    });
+    return res;
+  }
+
+  bool insert(std::initializer_list<value_type> il)
+  {
+    return insert(il.begin(),il.end());
+  }
+
+  /* Removes one occurrence of x. If x was not inserted, this may remove an
+   * element with the same fingerprint, which results in false negatives.
+   */
+
+  bool erase(const T& x)
+  {
+    return erase_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  bool erase(const U& x)
+  {
+    return erase_hash(hash_for(x));
+  }
+
+  template<typename InputIterator>
+  void erase(InputIterator first,InputIterator last)
+  {
+    bulk_apply(first,last,[this](std::uint64_t hash){erase_hash(hash);});
+  }
+
+  /* number of stored elements with the same fingerprint as x */
+
+  std::size_t count(const T& x)const
+  {
+    return count_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  std::size_t count(const U& x)const
+  {
+    return count_hash(hash_for(x));
+  }
+
+  template<typename ForwardIterator,typename F>
+  void count(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    bulk_lookup(first,last,f,[this](std::size_t q,std::uint64_t r){
+      return t.count(q,r);
+    });
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    bulk_lookup(first,last,f,[this](std::size_t q,std::uint64_t r){
+      return t.contains(q,r);
+    });
+  }
+
+  /* Doubles the number of slots by moving the highest remainder bit into
+   * the quotient, without access to the original elements. Throws
+   * std::length_error if only one remainder bit is left.
+   */
+
+  void resize()
+  {
+    if(t.rbits<=1){
+      BOOST_THROW_EXCEPTION(
+        std::length_error("quotient_filter can't be resized further"));
+    }
+    rebuild(t.qbits+1,t.qbits+t.rbits,[this]{return source{t,t,0,0};});
+  }
+
+  /* Adds the elements of x in a linear pass over both tables. Fingerprints
+   * of the filter with more fingerprint bits are truncated to match the
+   * other one, and the slot count is the largest of both or that needed for
+   * the combined size.
+   */
+
+  quotient_filter& merge(const quotient_filter& x)
+  {
+    if(this==&x){
+      quotient_filter y{x};
+      return merge(y);
+    }
+
+    std::size_t f1=fingerprint_bits(),f2=x.fingerprint_bits(),
+                f=f1<f2?f1:f2,
+                q=t.qbits>x.t.qbits?t.qbits:x.t.qbits;
+    while(max_size_for(q)<t.used+x.t.used)++q;
+    if(q>=f){
+      BOOST_THROW_EXCEPTION(
+        std::length_error("merged quotient_filter too large"));
+    }
+    rebuild(q,f,[&,this]{return source{t,x.t,f1-f,f2-f};});
+    size_+=x.size_;
+    return *this;
+  }
+
+  friend bool operator==(const quotient_filter& x,const quotient_filter& y)
+  {
+    if(x.size_!=y.size_)return false;
+    if(x.size_==0)return true;
+    return
+      x.t.qbits==y.t.qbits&&x.t.rbits==y.t.rbits&&
+      std::memcmp(x.t.words,y.t.words,x.t.num_words()*8)==0;
+  }
+
+  friend bool operator!=(const quotient_filter& x,const quotient_filter& y)
+  {
+    return !(x==y);
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  static constexpr std::size_t min_quotient_bits=6;
+
+  /* merges the ascending (fingerprint,count) sequences of two tables, with
+   * fingerprints shifted right by s1 and s2 respectively
+   */
+
+  struct source
+  {
+    source(
+      const table_type& t1,const table_type& t2,
+      std::size_t s1_,std::size_t s2_)noexcept:
+      c1{t1},c2{t2},s1{s1_},s2{s2_},
+      more1{c1.next(f1,n1)},more2{&t1!=&t2&&c2.next(f2,n2)}{}
+
+    bool next(std::uint64_t& f,std::size_t& n)noexcept
+    {
+      if(more1&&(!more2||(f1>>s1)<=(f2>>s2))){
+        f=f1>>s1;
+        n=n1;
+        more1=c1.next(f1,n1);
+        return true;
+      }
+      else if(more2){
+        f=f2>>s2;
+        n=n2;
+        more2=c2.next(f2,n2);
+        return true;
+      }
+      else return false;
+    }
+
+    table_type::cursor c1,c2;
+    std::size_t        s1,s2;
+    std::uint64_t      f1=0,f2=0;
+    std::size_t        n1=0,n2=0;
+    bool               more1,more2;
+  };
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  static std::size_t max_size_for(std::size_t qbits)noexcept
+  {
+    std::size_t n=std::size_t(1)<<qbits;
+    return n-n/10;
+  }
+
+  bool can_grow()const noexcept
+  {
+    return t.rbits>Bits;
+  }
+
+  bool insert_hash(std::uint64_t hash)
+  {
+    if(BOOST_UNLIKELY(!t.words))allocate_table(t);
+    else if(BOOST_UNLIKELY(t.used>=max_size_for(t.qbits))&&can_grow()){
+      resize();
+    }
+    std::size_t   q;
+    std::uint64_t r;
+    for(;;){
+      t.split(hash,q,r);
+      if(BOOST_LIKELY(t.insert(q,r)))break;
+      if(!can_grow())return false;
+      resize();
+    }
+    ++size_;
+    return true;
+  }
+
+  bool erase_hash(std::uint64_t hash)
+  {
+    if(!t.words)return false;
+    std::size_t   q;
+    std::uint64_t r;
+    t.split(hash,q,r);
+    if(!t.erase(q,r))return false;
+    --size_;
+    return true;
+  }
+
+  std::size_t count_hash(std::uint64_t hash)const
+  {
+    if(!t.words)return 0;
+    std::size_t   q;
+    std::uint64_t r;
+    t.split(hash,q,r);
+    return t.count(q,r);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    if(BOOST_UNLIKELY(!t.words))return false;
+    std::size_t   q;
+    std::uint64_t r;
+    t.split(hash,q,r);
+    return t.contains(q,r);
+  }
+
+  /* Hashes for a chunk of elements are calculated and their home blocks
+   * prefetched before any of them is processed.
+   */
+
+  template<typename InputIterator,typename Op>
+  void bulk_apply(InputIterator first,InputIterator last,Op op)
+  {
+    std::uint64_t hashes[bulk_operation_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<bulk_operation_size&&first!=last;++first,++n){
+        hashes[n]=hash_for(*first);
+        prefetch_hash(hashes[n]);
+      }
+      for(std::size_t i=0;i<n;++i)op(hashes[i]);
+    }
+  }
+
+  template<typename ForwardIterator,typename F,typename Op>
+  void bulk_lookup(ForwardIterator first,ForwardIterator last,F& f,Op op)const
+  {
+    std::size_t   qs[bulk_operation_size];
+    std::uint64_t rs[bulk_operation_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(auto it=first;n<bulk_operation_size&&it!=last;++it,++n){
+        if(t.words){
+          t.split(hash_for(*it),qs[n],rs[n]);
+          t.prefetch(qs[n]);
+        }
+      }
+      for(std::size_t i=0;i<n;++i){
+        f(*first++,t.words?op(qs[i],rs[i]):decltype(op(qs[i],rs[i]))(0));
+      }
+    }
+  }
+
+  void prefetch_hash(std::uint64_t hash)const noexcept
+  {
+    if(t.words){
+      std::size_t   q;
+      std::uint64_t r;
+      t.split(hash,q,r);
+      t.prefetch(q);
+    }
+  }
+
+  /* Builds a table with 2^qbits slots from the fingerprintbits-bit
+   * fingerprints (and their counts) provided by the sources returned by make_source, adding
+   * more slots on the rare event of overflow at the end of the table.
+   */
+
+  template<typename SourceFactory>
+  void rebuild(
+    std::size_t qbits,std::size_t fingerprint_bits,SourceFactory make_source)
+  {
+    for(;;){
+      table_type nt;
+      nt.qbits=qbits;
+      nt.rbits=fingerprint_bits-qbits;
+      allocate_table(nt);
+      auto src=make_source();
+      if(nt.assign(src)){
+        delete_table(t);
+        t=nt;
+        return;
+      }
+      delete_table(nt);
+      if(++qbits>=fingerprint_bits){
+        BOOST_THROW_EXCEPTION(
+          std::length_error("quotient_filter can't be resized further"));
+      }
+    }
+  }
+
+  void allocate_table(table_type& tt)
+  {
+    word_allocator_type wal{al_};
+    std::size_t         nb=table_type::blocks_for(tt.qbits);
+    tt.words=allocator_allocate(wal,nb*tt.block_words());
+    tt.num_blocks=nb;
+    tt.used=tt.distinct=0;
+    std::memset(tt.words,0,tt.num_words()*8);
+  }
+
+  void delete_table(table_type& tt)noexcept
+  {
+    if(tt.words){
+      word_allocator_type wal{al_};
+      allocator_deallocate(wal,tt.words,tt.num_words());
+      tt.words=nullptr;
+      tt.num_blocks=tt.used=tt.distinct=0;
+    }
+  }
+
+  void copy_table(const quotient_filter& x)
+  {
+    t.qbits=x.t.qbits;
+    t.rbits=x.t.rbits;
+    if(x.t.words){
+      allocate_table(t);
+      std::memcpy(t.words,x.t.words,x.t.num_words()*8);
+      t.used=x.t.used;
+      t.distinct=x.t.distinct;
+    }
+    size_=x.size_;
+  }
+
+  allocator_type al_;
+  table_type     t;
+  std::size_t    size_=0;
+};
+
+template<
+  typename T,std::size_t Bits,std::size_t MaxQuotientBits,
+  typename Hash,typename Allocator
+>
+void swap(
+  quotient_filter<T,Bits,MaxQuotientBits,Hash,Allocator>& x,
+  quotient_filter<T,Bits,MaxQuotientBits,Hash,Allocator>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
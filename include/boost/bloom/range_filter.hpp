@@ -0,0 +1,401 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_RANGE_FILTER_HPP
+#define BOOST_BLOOM_RANGE_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Range filter for integer keys along the lines of Rosetta (Luo et al.,
+ * 2020). Each key x is inserted at levels 0,...,L as its prefix x>>l, so
+ * that level l holds the dyadic intervals of width 2^l containing some key.
+ * A range [a,b] no wider than 2^L is decomposed into at most 2L maximal
+ * dyadic intervals, all of which are prefetched before being looked up;
+ * intervals found at level l>0 are then "doubted", i.e. their two halves
+ * are recursively looked up down to level 0, which brings the FPR of wide
+ * intervals close to that of point lookups. All levels share one
+ * filter_core, with the level mixed into the hash of each prefix.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Allocator=std::allocator<unsigned char>
+>
+class range_filter
+{
+  static_assert(
+    std::is_integral<T>::value&&!std::is_same<T,bool>::value&&
+    std::numeric_limits<T>::digits+std::numeric_limits<T>::is_signed<=64,
+    "T must be an integral type of at most 64 bits other than bool");
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using core_type=detail::filter_core<K,Subfilter,Stride,Allocator>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  using subfilter=Subfilter;
+  static constexpr std::size_t stride=core_type::stride;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=core_type::bulk_insert_size;
+  static constexpr std::size_t bulk_may_contain_size=
+    core_type::bulk_may_contain_size;
+
+  explicit range_filter(
+    std::size_t m=0,std::uint64_t w=1,
+    const allocator_type& al=allocator_type()):
+    core{m,al},levels_{levels_for(w)}{}
+
+  range_filter(
+    std::size_t n,double fpr,std::uint64_t w,
+    const allocator_type& al=allocator_type()):
+    range_filter{capacity_for(n,fpr,w),w,al}{}
+
+  template<typename InputIterator>
+  range_filter(
+    InputIterator first,InputIterator last,
+    std::size_t m,std::uint64_t w,const allocator_type& al=allocator_type()):
+    range_filter{m,w,al}
+  {
+    insert(first,last);
+  }
+
+  template<typename InputIterator>
+  range_filter(
+    InputIterator first,InputIterator last,
+    std::size_t n,double fpr,std::uint64_t w,
+    const allocator_type& al=allocator_type()):
+    range_filter{n,fpr,w,al}
+  {
+    insert(first,last);
+  }
+
+  range_filter(
+    std::initializer_list<value_type> il,
+    std::size_t m,std::uint64_t w,const allocator_type& al=allocator_type()):
+    range_filter{il.begin(),il.end(),m,w,al}{}
+
+  range_filter(
+    std::initializer_list<value_type> il,
+    std::size_t n,double fpr,std::uint64_t w,
+    const allocator_type& al=allocator_type()):
+    range_filter{il.begin(),il.end(),n,fpr,w,al}{}
+
+  range_filter(const range_filter&)=default;
+  range_filter(range_filter&&)=default;
+  range_filter& operator=(const range_filter&)=default;
+  range_filter& operator=(range_filter&&)=default;
+
+  allocator_type get_allocator()const noexcept
+  {
+    return core.get_allocator();
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return core.capacity();
+  }
+
+  std::uint64_t max_range_width()const noexcept
+  {
+    return std::uint64_t(1)<<levels_;
+  }
+
+  /* Capacity for a point lookup FPR of fpr with n keys, each of which
+   * takes one entry per level.
+   */
+
+  static std::size_t capacity_for(std::size_t n,double fpr,std::uint64_t w)
+  {
+    return core_type::capacity_for(n*(levels_for(w)+1),fpr);
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    auto u=to_unsigned(x);
+    for(std::size_t l=0;l<=levels_;++l)core.insert(hash_for(u>>l,l));
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    std::uint64_t hashes[insert_buffer_size];
+    std::uint64_t u=0;
+    std::size_t   l=levels_+1;
+    for(;;){
+      std::size_t n=0;
+      for(;n<insert_buffer_size;++n){
+        if(l>levels_){
+          if(first==last)break;
+          u=to_unsigned(*first++);
+          l=0;
+        }
+        hashes[n]=hash_for(u>>l,l);
+        ++l;
+      }
+      const std::uint64_t* p=hashes;
+      core.bulk_insert([&p]{return *p++;},n);
+      if(n<insert_buffer_size)break;
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void swap(range_filter& x)
+    noexcept(noexcept(std::declval<core_type&>().swap(
+      std::declval<core_type&>())))
+  {
+    using std::swap;
+
+    core.swap(x.core);
+    swap(levels_,x.levels_);
+  }
+
+  void clear()noexcept
+  {
+    core.clear();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return core.may_contain(hash_for(to_unsigned(x),0));
+  }
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    core.bulk_may_contain(
+      [first]()mutable{return hash_for(to_unsigned(*first++),0);},
+      static_cast<std::size_t>(std::distance(first,last)),
+      [&f,first](bool res)mutable{f(*first++,res);});
+  }
+
+  /* may any key in [a,b] have been inserted? */
+
+  bool may_contain_range(const T& a,const T& b)const
+  {
+    probe_buffer buf;
+    if(!decompose(to_unsigned(a),to_unsigned(b),buf))return true;
+    return check(buf,0,buf.size);
+  }
+
+  /* Ranges are given as pairs of keys, and their dyadic intervals are
+   * accumulated until probe_buffer_size is reached and then prefetched all
+   * at once.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void may_contain_range(
+    ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    probe_buffer buf;
+    std::size_t  ends[probe_buffer_size]; /* end of each range in buf */
+    while(first!=last){
+      std::size_t n=0;
+      buf.size=0;
+      for(auto it=first;it!=last&&n<probe_buffer_size;++it){
+        if(buf.size+max_intervals()>probe_buffer_size)break;
+        const auto& r=*it;
+        if(!decompose(to_unsigned(r.first),to_unsigned(r.second),buf)){
+          ends[n++]=(std::size_t)-1; /* wider than max_range_width() */
+        }
+        else ends[n++]=buf.size;
+      }
+      for(std::size_t i=0,begin=0;i<n;++i,++first){
+        if(ends[i]==(std::size_t)-1){
+          f(*first,true);
+        }
+        else{
+          f(*first,check(buf,begin,ends[i]));
+          begin=ends[i];
+        }
+      }
+    }
+  }
+
+private:
+  template<
+    typename T1,std::size_t K1,typename SF,std::size_t S,typename A
+  >
+  bool friend operator==(
+    const range_filter<T1,K1,SF,S,A>& x,const range_filter<T1,K1,SF,S,A>& y);
+
+  using unsigned_type=typename std::make_unsigned<T>::type;
+  static constexpr std::size_t digits=
+    std::numeric_limits<unsigned_type>::digits;
+  static constexpr std::size_t max_levels=digits<64?digits:63;
+  static constexpr std::size_t insert_buffer_size=4*bulk_insert_size;
+  static constexpr std::size_t probe_buffer_size=128;
+  static_assert(
+    2*max_levels+1<=probe_buffer_size,
+    "probe_buffer_size must hold the intervals of any range");
+
+  struct probe_buffer
+  {
+    std::uint64_t        prefixes[probe_buffer_size];
+    std::size_t          levels[probe_buffer_size];
+    std::uint64_t        hashes[probe_buffer_size];
+    const unsigned char* positions[probe_buffer_size];
+    std::size_t          size=0;
+  };
+
+  static std::size_t levels_for(std::uint64_t w)noexcept
+  {
+    std::size_t res=w>1?(std::size_t)boost::core::bit_width(w-1):0;
+    return res<max_levels?res:max_levels;
+  }
+
+  /* upper bound on the number of dyadic intervals of a range */
+
+  std::size_t max_intervals()const noexcept
+  {
+    return 2*levels_+1;
+  }
+
+  /* maps T to std::uint64_t preserving order */
+
+  static BOOST_FORCEINLINE std::uint64_t to_unsigned(const T& x)noexcept
+  {
+    return (std::uint64_t)((unsigned_type)x^sign_bit(std::is_signed<T>{}));
+  }
+
+  static constexpr unsigned_type sign_bit(std::true_type)noexcept
+  {
+    return (unsigned_type)(unsigned_type(1)<<(digits-1));
+  }
+
+  static constexpr unsigned_type sign_bit(std::false_type)noexcept
+  {
+    return 0;
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t hash_for(
+    std::uint64_t prefix,std::size_t l)noexcept
+  {
+    return detail::mulx64(prefix+l*0xf1357aea2e62a9c5ull);
+  }
+
+  /* Appends to buf the maximal dyadic intervals covering [a,b] and starts
+   * their lookup. Returns false (and appends nothing) if the range is
+   * wider than max_range_width(). Empty ranges (a>b) have no intervals.
+   */
+
+  bool decompose(std::uint64_t a,std::uint64_t b,probe_buffer& buf)const
+  {
+    if(a>b)return true;
+    if(b-a>=max_range_width())return false;
+    for(;;){
+      std::size_t l=
+        (std::size_t)boost::core::bit_width(b-a+1)-1; /* fits in [a,b] */
+      if(a){
+        std::size_t align=(std::size_t)boost::core::countr_zero(a);
+        if(align<l)l=align;
+      }
+      auto& i=buf.size;
+      buf.prefixes[i]=a>>l;
+      buf.levels[i]=l;
+      buf.hashes[i]=hash_for(a>>l,l);
+      buf.positions[i]=core.start_may_contain(buf.hashes[i]);
+      ++i;
+      std::uint64_t last=a+((std::uint64_t(1)<<l)-1);
+      if(last==b)return true;
+      a=last+1;
+    }
+  }
+
+  bool check(const probe_buffer& buf,std::size_t first,std::size_t last)const
+  {
+    for(std::size_t i=first;i<last;++i){
+      if(core.finish_may_contain(buf.positions[i],buf.hashes[i])&&
+         doubt(buf.prefixes[i],buf.levels[i]))return true;
+    }
+    return false;
+  }
+
+  /* checks whether any of the two halves of a positive interval at level
+   * l is found down to level 0
+   */
+
+  bool doubt(std::uint64_t prefix,std::size_t l)const
+  {
+    if(l==0)return true;
+    --l;
+    std::uint64_t        hash0=hash_for(prefix<<1,l),
+                         hash1=hash_for((prefix<<1)+1,l);
+    const unsigned char* p0=core.start_may_contain(hash0);
+    const unsigned char* p1=core.start_may_contain(hash1);
+    return
+      (core.finish_may_contain(p0,hash0)&&doubt(prefix<<1,l))||
+      (core.finish_may_contain(p1,hash1)&&doubt((prefix<<1)+1,l));
+  }
+
+  core_type   core;
+  std::size_t levels_;
+};
+
+template<typename T,std::size_t K,typename SF,std::size_t S,typename A>
+bool operator==(
+  const range_filter<T,K,SF,S,A>& x,const range_filter<T,K,SF,S,A>& y)
+{
+  return x.levels_==y.levels_&&x.core==y.core;
+}
+
+template<typename T,std::size_t K,typename SF,std::size_t S,typename A>
+bool operator!=(
+  const range_filter<T,K,SF,S,A>& x,const range_filter<T,K,SF,S,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,std::size_t K,typename SF,std::size_t S,typename A>
+void swap(range_filter<T,K,SF,S,A>& x,range_filter<T,K,SF,S,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,576 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_RIBBON_FILTER_HPP
+#define BOOST_BLOOM_RIBBON_FILTER_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/ribbon_parities.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Standard Ribbon filter (Dillinger and Walzer, 2021) for a static set of
+ * elements. Each element is mapped to a row equation
+ *   XOR{Z[s+i]: bit i of c is set}=r,
+ * where s is a start column, c a 64-bit coefficient vector with its lowest
+ * bit set and r a Bits-bit fingerprint; lookup evaluates the left side on
+ * the stored solution Z and compares with r, so the FPR is 2^-Bits.
+ *
+ * Elements are distributed among shards of about shard_size elements, each
+ * solved independently by on-the-fly banded Gaussian elimination followed
+ * by back substitution. Shards keep the space overhead low (the overhead
+ * needed for the system to be solvable grows with its size), confine
+ * construction retries (with a new seed) to the shard that failed, and can
+ * be built in parallel.
+ *
+ * The solution of each shard is stored in interleaved column-major layout:
+ * columns are grouped in blocks of 64, and block b consists of Bits words
+ * whose i-th bit is bit j of Z[64*b+i] for word j. A lookup then reads
+ * 2*Bits consecutive words and computes Bits parities.
+ */
+
+template<
+  typename T,std::size_t Bits=8,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class ribbon_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(Bits>0&&Bits<=32,"Bits must be in [1,32]");
+  using mix_policy=detail::mix_policy_for<Hash>;
+  using word_allocator_type=allocator_rebind_t<Allocator,std::uint64_t>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t bits=Bits;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t shard_size=4096;
+  static constexpr std::size_t bulk_may_contain_size=16;
+
+  explicit ribbon_filter(
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al}{}
+
+  template<typename ForwardIterator>
+  ribbon_filter(
+    ForwardIterator first,ForwardIterator last,std::size_t num_threads=1,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    ribbon_filter{h,al}
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+    build(first,(std::size_t)std::distance(first,last),num_threads);
+  }
+
+  ribbon_filter(
+    std::initializer_list<value_type> il,std::size_t num_threads=1,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    ribbon_filter{il.begin(),il.end(),num_threads,h,al}{}
+
+  ribbon_filter(const ribbon_filter& x):
+    ribbon_filter{
+      x,allocator_select_on_container_copy_construction(x.al_)}{}
+
+  ribbon_filter(ribbon_filter&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},al_{std::move(x.al_)},
+    num_shards{x.num_shards},size_{x.size_},words{x.words}
+  {
+    x.num_shards=x.size_=0;
+    x.words=nullptr;
+  }
+
+  ribbon_filter(const ribbon_filter& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},al_{al}
+  {
+    copy_words(x);
+  }
+
+  ~ribbon_filter()noexcept
+  {
+    delete_words();
+  }
+
+  ribbon_filter& operator=(const ribbon_filter& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      delete_words();
+      detail::copy_assign_if<pocca>(al_,x.al_);
+      h()=x.h();
+      copy_words(x);
+    }
+    return *this;
+  }
+
+  ribbon_filter& operator=(ribbon_filter&& x)noexcept(
+    allocator_propagate_on_container_move_assignment_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al_==x.al_){
+        delete_words();
+        detail::move_assign_if<pocma>(al_,x.al_);
+        h()=std::move(x.h());
+        num_shards=x.num_shards;
+        size_=x.size_;
+        words=x.words;
+        x.num_shards=x.size_=0;
+        x.words=nullptr;
+      }
+      else *this=static_cast<const ribbon_filter&>(x);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  /* number of bits used, including per-shard metadata */
+
+  std::size_t capacity()const noexcept
+  {
+    return size_*64;
+  }
+
+  std::size_t shard_count()const noexcept
+  {
+    return num_shards;
+  }
+
+  static constexpr double fpr()noexcept
+  {
+    return 1.0/(double)(std::uint64_t(1)<<Bits);
+  }
+
+  void swap(ribbon_filter& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    BOOST_ASSERT(pocs||al_==x.al_);
+    detail::swap_if<pocs>(al_,x.al_);
+    std::swap(h(),x.h());
+    std::swap(num_shards,x.num_shards);
+    std::swap(size_,x.size_);
+    std::swap(words,x.words);
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  /* Rows for a chunk of elements are calculated and their blocks prefetched
+   * before any of them is checked.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    row                  rows[bulk_may_contain_size];
+    const std::uint64_t* blocks[bulk_may_contain_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(auto it=first;n<bulk_may_contain_size&&it!=last;++it,++n){
+        auto hash=promoting_hash_for(*it);
+        blocks[n]=num_shards?
+          prefetch_row(shard_for(hash),hash,rows[n]):nullptr;
+      }
+      for(std::size_t i=0;i<n;++i){
+        f(*first++,blocks[i]&&check_row(blocks[i],rows[i]));
+      }
+    }
+  }
+
+  friend bool operator==(const ribbon_filter& x,const ribbon_filter& y)
+  {
+    return
+      x.size_==y.size_&&
+      (x.size_==0||std::memcmp(x.words,y.words,x.size_*8)==0);
+  }
+
+  friend bool operator!=(const ribbon_filter& x,const ribbon_filter& y)
+  {
+    return !(x==y);
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  /* words starts with two metadata words per shard: the position in words
+   * of its first block and (num_starts<<32)+seed. A zero block is appended so that
+   * lookups can always read two consecutive blocks.
+   */
+
+  static constexpr std::size_t meta_words=2;
+  static constexpr std::size_t block_words=Bits;
+  static constexpr std::size_t cacheline=BOOST_BLOOM_CACHELINE_SIZE;
+  static constexpr std::size_t prefetched_cachelines=
+    1+(2*block_words*8+cacheline-2)/cacheline;
+
+  struct row
+  {
+    std::uint64_t start;
+    std::uint64_t coeffs;
+    std::uint32_t result;
+  };
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const T& x)const
+  {
+    return hash_for(x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const U& x)const
+  {
+    return hash_for(x);
+  }
+
+  static std::size_t shard_for(std::uint64_t hash,std::size_t n)noexcept
+  {
+    std::uint64_t hi;
+    detail::umul128(hash,n,hi);
+    return (std::size_t)hi;
+  }
+
+  std::size_t shard_for(std::uint64_t hash)const noexcept
+  {
+    return shard_for(hash,num_shards);
+  }
+
+  /* The shard is selected from the high bits of hash, so row components
+   * are drawn from a seeded remix of it.
+   */
+
+  static BOOST_FORCEINLINE row make_row(
+    std::uint64_t hash,std::uint64_t num_starts,std::uint32_t seed)noexcept
+  {
+    static constexpr std::uint32_t result_mask=
+      (std::uint32_t)((std::uint64_t(1)<<Bits)-1);
+
+    row r;
+    hash=detail::mulx64(hash+(seed+1)*0x9E3779B97F4A7C15ull);
+    detail::umul128(hash,num_starts,r.start);
+    r.coeffs=detail::mulx64(hash)|1;
+    r.result=(std::uint32_t)hash&result_mask;
+    return r;
+  }
+
+  BOOST_FORCEINLINE const std::uint64_t* prefetch_row(
+    std::size_t shard,std::uint64_t hash,row& r)const noexcept
+  {
+    auto meta=words+shard*meta_words;
+    r=make_row(hash,meta[1]>>32,(std::uint32_t)meta[1]);
+    auto p=words+meta[0]+r.start/64*block_words;
+    for(std::size_t i=0;i<prefetched_cachelines;++i){
+      BOOST_BLOOM_PREFETCH((const unsigned char*)p+i*cacheline);
+    }
+    return p;
+  }
+
+  static BOOST_FORCEINLINE bool check_row(
+    const std::uint64_t* p,const row& r)noexcept
+  {
+    auto off=(unsigned int)(r.start%64);
+    return detail::ribbon_parities<block_words>(
+      p,r.coeffs<<off,p+block_words,(r.coeffs>>1)>>(63-off))==r.result;
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    if(BOOST_UNLIKELY(num_shards==0))return false;
+    row r;
+    return check_row(prefetch_row(shard_for(hash),hash,r),r);
+  }
+
+  static std::size_t blocks_for(std::size_t n)noexcept
+  {
+    /* about 5% overhead, enough for ~90% construction success per seed */
+
+    return (n+n/32+63)/64+1;
+  }
+
+  template<typename ForwardIterator>
+  void build(ForwardIterator first,std::size_t n,std::size_t num_threads)
+  {
+    if(n==0)return;
+
+    std::size_t ns=(n+shard_size-1)/shard_size;
+
+    /* counting sort of hash values by shard, hashing twice to save memory */
+
+    detail::temporary_buffer<std::uint64_t,allocator_type> hashes{al_,n};
+    detail::temporary_buffer<std::size_t,allocator_type>   offsets{al_,ns+1};
+    auto offs=offsets.data();
+    std::fill(offs,offs+ns+1,std::size_t(0));
+    auto it=first;
+    for(std::size_t i=0;i<n;++i,++it){
+      ++offs[shard_for(promoting_hash_for(*it),ns)+1];
+    }
+    std::size_t max_count=0;
+    for(std::size_t i=1;i<=ns;++i){
+      if(offs[i]>max_count)max_count=offs[i];
+      offs[i]+=offs[i-1];
+    }
+    for(std::size_t i=0;i<n;++i,++first){
+      auto hash=promoting_hash_for(*first);
+      hashes.data()[offs[shard_for(hash,ns)]++]=hash;
+    }
+    for(std::size_t i=ns;i>0;--i)offs[i]=offs[i-1];
+    offs[0]=0;
+
+    /* shard layout */
+
+    /* solver buffers, one per thread */
+
+    if(num_threads>ns)num_threads=ns;
+    if(num_threads<1)num_threads=1;
+    std::size_t max_slots=blocks_for(max_count)*64;
+    detail::temporary_buffer<std::uint64_t,allocator_type> coeffs{
+      al_,num_threads*max_slots};
+    detail::temporary_buffer<std::uint32_t,allocator_type> results{
+      al_,num_threads*max_slots};
+
+    std::size_t size=ns*meta_words;
+    for(std::size_t i=0;i<ns;++i){
+      size+=blocks_for(offs[i+1]-offs[i])*block_words;
+    }
+    size+=block_words;
+    auto p=allocate_words(size);
+    std::memset(p,0,size*8);
+    for(std::size_t i=0,pos=ns*meta_words;i<ns;++i){
+      p[i*meta_words]=pos;
+      pos+=blocks_for(offs[i+1]-offs[i])*block_words;
+    }
+    num_shards=ns;
+    size_=size;
+    words=p;
+
+    auto work=[&,this](std::size_t t)noexcept{
+      for(std::size_t i=t;i<ns;i+=num_threads){
+        build_shard(
+          i,hashes.data()+offs[i],offs[i+1]-offs[i],
+          coeffs.data()+t*max_slots,results.data()+t*max_slots);
+      }
+    };
+
+    if(num_threads==1)work(0);
+    else{
+      std::vector<std::thread> threads;
+      BOOST_TRY{
+        threads.reserve(num_threads-1);
+        for(std::size_t t=1;t<num_threads;++t)threads.emplace_back(work,t);
+      }
+      BOOST_CATCH(...){
+        for(auto& th:threads)th.join();
+        BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      work(0);
+      for(auto& th:threads)th.join();
+    }
+  }
+
+  void build_shard(
+    std::size_t shard,const std::uint64_t* hashes,std::size_t n,
+    std::uint64_t* coeffs,std::uint32_t* results)noexcept
+  {
+    auto        meta=words+shard*meta_words;
+    std::size_t num_blocks=blocks_for(n),
+                num_slots=num_blocks*64,
+                num_starts=num_slots-63;
+
+    std::uint32_t seed=0;
+    while(!eliminate(hashes,n,num_starts,seed,coeffs,results))++seed;
+    meta[1]=((std::uint64_t)num_starts<<32)+seed;
+    back_substitute(num_slots,coeffs,results,words+meta[0]);
+  }
+
+  /* On-the-fly banded Gaussian elimination: each row is xored with the
+   * stored row at its leading column until it finds an empty slot, which
+   * keeps the system in upper triangular form. Redundant rows (duplicate
+   * elements) reduce to 0=0, inconsistent ones to 0=r!=0, which makes
+   * construction fail for this seed.
+   */
+
+  static bool eliminate(
+    const std::uint64_t* hashes,std::size_t n,
+    std::size_t num_starts,std::uint32_t seed,
+    std::uint64_t* coeffs,std::uint32_t* results)noexcept
+  {
+    std::memset(coeffs,0,(num_starts+63)*sizeof(std::uint64_t));
+    std::memset(results,0,(num_starts+63)*sizeof(std::uint32_t));
+    for(std::size_t i=0;i<n;++i){
+      auto r=make_row(hashes[i],num_starts,seed);
+      auto s=(std::size_t)r.start;
+      for(;;){
+        if(!coeffs[s]){
+          coeffs[s]=r.coeffs;
+          results[s]=r.result;
+          break;
+        }
+        r.coeffs^=coeffs[s];
+        r.result^=results[s];
+        if(!r.coeffs){
+          if(r.result)return false;
+          break;
+        }
+        auto shift=boost::core::countr_zero(r.coeffs);
+        s+=(std::size_t)shift;
+        r.coeffs>>=shift;
+      }
+    }
+    return true;
+  }
+
+  /* Solution values are calculated from the last column to the first,
+   * keeping for each result bit a window with the values of the 64 columns
+   * starting at the current one, which is stored every 64 columns. Free
+   * columns (no row) are set to zero, as their coefficients and results
+   * are zero.
+   */
+
+  static void back_substitute(
+    std::size_t num_slots,const std::uint64_t* coeffs,
+    const std::uint32_t* results,std::uint64_t* p)noexcept
+  {
+    std::uint64_t window[block_words]={};
+    for(std::size_t s=num_slots;s--;){
+      auto c=coeffs[s];
+      auto r=results[s];
+      for(std::size_t j=0;j<block_words;++j){
+        auto w=window[j]<<1;
+        window[j]=w|(std::uint64_t)(
+          (boost::core::popcount(w&c)^(r>>j))&1);
+      }
+      if(s%64==0){
+        std::memcpy(p+s/64*block_words,window,sizeof(window));
+      }
+    }
+  }
+
+  std::uint64_t* allocate_words(std::size_t n)
+  {
+    word_allocator_type wal{al_};
+    return allocator_allocate(wal,n);
+  }
+
+  void delete_words()noexcept
+  {
+    if(words){
+      word_allocator_type wal{al_};
+      allocator_deallocate(wal,words,size_);
+      words=nullptr;
+      num_shards=size_=0;
+    }
+  }
+
+  void copy_words(const ribbon_filter& x)
+  {
+    if(x.words){
+      words=allocate_words(x.size_);
+      std::memcpy(words,x.words,x.size_*8);
+    }
+    num_shards=x.num_shards;
+    size_=x.size_;
+  }
+
+  allocator_type al_;
+  std::size_t    num_shards=0;
+  std::size_t    size_=0;
+  std::uint64_t* words=nullptr;
+};
+
+template<typename T,std::size_t Bits,typename Hash,typename Allocator>
+void swap(
+  ribbon_filter<T,Bits,Hash,Allocator>& x,
+  ribbon_filter<T,Bits,Hash,Allocator>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,50 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_SECTORIZED_BLOCK_HPP
+#define BOOST_BLOOM_SECTORIZED_BLOCK_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/sectorized_block_fpr_base.hpp>
+#include <boost/bloom/detail/sectorized_block_impl.hpp>
+#include <cstddef>
+
+#if defined(BOOST_BLOOM_AVX2)
+#include <boost/bloom/detail/sectorized_block_avx2.hpp>
+#endif
+
+namespace boost{
+namespace bloom{
+
+/* Cache-sectorized block as described in Lang et al. 2019
+ * https://www.vldb.org/pvldb/vol12/p502-lang.pdf : K bits are distributed
+ * evenly among the Sectors elements of a Block[Sectors] subarray.
+ */
+
+template<typename Block,std::size_t Sectors,std::size_t K>
+struct sectorized_block:
+  public detail::sectorized_block_fpr_base<Sectors,K>,
+  private detail::sectorized_block_impl<Block,Sectors,K>
+{
+  static_assert(Sectors>0,"Sectors must be greater than zero");
+  static_assert(K>=Sectors,"K must be greater than or equal to Sectors");
+  static constexpr std::size_t k=K;
+  static constexpr std::size_t sectors=Sectors;
+  using value_type=Block[Sectors];
+
+private:
+  using super=detail::sectorized_block_impl<Block,Sectors,K>;
+
+public:
+  using super::mark;
+  using super::check;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,352 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_SHARDED_FILTER_HPP
+#define BOOST_BLOOM_SHARDED_FILTER_HPP
+
+#include <algorithm>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/spinlock.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* sharded_filter splits its capacity among a number of independent
+ * filter_cores (shards), each protected by its own spinlock. The shard an
+ * element goes to is selected from a remix of its hash value: using the hash
+ * directly would correlate shard selection with positions within the shard,
+ * as fastrange_and_mcg draws positions mostly from high hash bits.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class sharded_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using core_type=detail::filter_core<K,Subfilter,Stride,Allocator>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+  struct shard
+  {
+    shard(std::size_t m,const Allocator& al):core{m,al}{}
+
+    detail::spinlock mtx;
+    core_type        core;
+    unsigned char    padding[BOOST_BLOOM_CACHELINE_SIZE]; /* false sharing */
+  };
+  using shard_allocator_type=allocator_rebind_t<Allocator,shard>;
+  using lock_guard=std::lock_guard<detail::spinlock>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=core_type::k;
+  using subfilter=typename core_type::subfilter;
+  static constexpr std::size_t stride=core_type::stride;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=256;
+
+  sharded_filter(
+    std::size_t m,std::size_t num_shards,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},al_{al},
+    n{checked_shard_count(num_shards)},
+    shards{new_shards(al_,n,(m+n-1)/n)}{}
+
+  sharded_filter(
+    std::size_t n_,double fpr,std::size_t num_shards,
+    const hasher& h=hasher(),const allocator_type& al=allocator_type()):
+    sharded_filter{capacity_for(n_,fpr),num_shards,h,al}{}
+
+  sharded_filter(const sharded_filter&)=delete;
+  sharded_filter& operator=(const sharded_filter&)=delete;
+
+  ~sharded_filter()noexcept
+  {
+    delete_shards(al_,shards,n);
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al_;
+  }
+
+  std::size_t shard_count()const noexcept
+  {
+    return n;
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    std::size_t res=0;
+    for(std::size_t i=0;i<n;++i){
+      lock_guard lck{shards[i].mtx};
+      res+=shards[i].core.capacity();
+    }
+    return res;
+  }
+
+  static std::size_t capacity_for(std::size_t n_,double fpr)
+  {
+    return core_type::capacity_for(n_,fpr);
+  }
+
+  static double fpr_for(std::size_t n_,std::size_t m)
+  {
+    return core_type::fpr_for(n_,m);
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  /* Elements are processed in chunks of bulk_insert_size which are grouped
+   * by shard so that each shard lock is taken once per chunk.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    std::pair<std::size_t,std::uint64_t> buf[bulk_insert_size];
+    while(first!=last){
+      std::size_t m=0;
+      do{
+        auto hash=promoting_hash_for(*first++);
+        buf[m++]={shard_for(hash),hash};
+      }while(m<bulk_insert_size&&first!=last);
+      std::sort(
+        buf,buf+m,
+        [](const std::pair<std::size_t,std::uint64_t>& x,
+           const std::pair<std::size_t,std::uint64_t>& y)
+        {return x.first<y.first;});
+      for(std::size_t i=0;i<m;){
+        auto j=i+1;
+        while(j<m&&buf[j].first==buf[i].first)++j;
+        auto&      s=shards[buf[i].first];
+        auto       p=buf+i;
+        lock_guard lck{s.mtx};
+        s.core.bulk_insert([p]()mutable{return (p++)->second;},j-i);
+        i=j;
+      }
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void clear()noexcept
+  {
+    for(std::size_t i=0;i<n;++i){
+      lock_guard lck{shards[i].mtx};
+      shards[i].core.clear();
+    }
+  }
+
+  void reset(std::size_t m=0)
+  {
+    for(std::size_t i=0;i<n;++i){
+      lock_guard lck{shards[i].mtx};
+      shards[i].core.reset((m+n-1)/n);
+    }
+  }
+
+  void reset(std::size_t n_,double fpr)
+  {
+    reset(capacity_for(n_,fpr));
+  }
+
+  sharded_filter& operator&=(const sharded_filter& x)
+  {
+    combine(x,[](core_type& a,const core_type& b){a&=b;});
+    return *this;
+  }
+
+  sharded_filter& operator|=(const sharded_filter& x)
+  {
+    combine(x,[](core_type& a,const core_type& b){a|=b;});
+    return *this;
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+private:
+  using hash_base=empty_value<Hash,0>;
+
+  const Hash& h()const{return hash_base::get();}
+
+  static std::size_t checked_shard_count(std::size_t num_shards)
+  {
+    if(num_shards==0){
+      BOOST_THROW_EXCEPTION(
+        std::invalid_argument("number of shards must be greater than zero"));
+    }
+    return num_shards;
+  }
+
+  static shard* new_shards(
+    const allocator_type& al,std::size_t num_shards,std::size_t m)
+  {
+    shard_allocator_type sal{al};
+    shard*               p=allocator_allocate(sal,num_shards);
+    std::size_t          i=0;
+    BOOST_TRY{
+      for(;i<num_shards;++i)allocator_construct(sal,p+i,m,al);
+    }
+    BOOST_CATCH(...){
+      while(i--)allocator_destroy(sal,p+i);
+      allocator_deallocate(sal,p,num_shards);
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    return p;
+  }
+
+  static void delete_shards(
+    const allocator_type& al,shard* p,std::size_t num_shards)noexcept
+  {
+    shard_allocator_type sal{al};
+    for(std::size_t i=0;i<num_shards;++i)allocator_destroy(sal,p+i);
+    allocator_deallocate(sal,p,num_shards);
+  }
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const T& x)const
+  {
+    return hash_for(x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t promoting_hash_for(const U& x)const
+  {
+    return hash_for(x);
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::size_t shard_for(std::uint64_t hash)const noexcept
+  {
+    std::uint64_t hi;
+    detail::umul128(detail::mulx64(hash),n,hi);
+    return (std::size_t)hi;
+  }
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    auto&      s=shards[shard_for(hash)];
+    lock_guard lck{s.mtx};
+    s.core.insert(hash);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    auto&      s=shards[shard_for(hash)];
+    lock_guard lck{s.mtx};
+    return s.core.may_contain(hash);
+  }
+
+  /* Shard pairs are locked in address order to avoid deadlocks with
+   * concurrent y.combine(x) operations.
+   */
+
+  template<typename F>
+  void combine(const sharded_filter& x,F f)
+  {
+    if(n!=x.n){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
+    }
+    if(this==&x)return;
+    for(std::size_t i=0;i<n;++i){
+      auto& s1=shards[i];
+      auto& s2=x.shards[i];
+      bool  this_first=std::less<const shard*>()(&s1,&s2);
+      lock_guard lck1{this_first?s1.mtx:s2.mtx};
+      lock_guard lck2{this_first?s2.mtx:s1.mtx};
+      f(s1.core,s2.core);
+    }
+  }
+
+  allocator_type  al_;
+  std::size_t     n;
+  shard*          shards;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,344 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_STABLE_FILTER_HPP
+#define BOOST_BLOOM_STABLE_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/stable_block.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Stable Bloom filter (Deng and Rafiei, 2006). Each insertion decrements p
+ * cells before setting the K cells of the element to their maximum value, so
+ * that old elements are progressively forgotten and the FPR converges to a
+ * fixed value regardless of the length of the stream. Cells live in a
+ * filter_core with K=1 whose subfilter, stable_block, holds the K cells of
+ * each element within a single cache line. Decrements are applied to the
+ * same block, which keeps insertion to one memory access and makes the
+ * stationary FPR independent of the capacity, and affect a run of p cells
+ * starting at a random position rather than p scattered cells, so that they
+ * can be done word by word: each cell is still decremented with probability
+ * p/m, which is what the analysis relies on.
+ */
+
+template<
+  typename T,std::size_t K,std::size_t CellWidth=2,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class stable_filter:empty_value<Hash,0>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  using block_type=detail::stable_block<K,CellWidth>;
+  using core_type=detail::filter_core<1,block_type,0,Allocator>;
+  using mix_policy=detail::mix_policy_for<Hash>;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  static constexpr std::size_t cell_width=CellWidth;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  static constexpr std::size_t bulk_insert_size=core_type::bulk_insert_size;
+  static constexpr std::size_t bulk_may_contain_size=
+    core_type::bulk_may_contain_size;
+
+  explicit stable_filter(
+    std::size_t m=0,std::size_t p=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},core{m,al},decrements_{p}{}
+
+  stable_filter(std::size_t m,std::size_t p,const allocator_type& al):
+    stable_filter{m,p,hasher(),al}{}
+
+  template<typename InputIterator>
+  stable_filter(
+    InputIterator first,InputIterator last,
+    std::size_t m,std::size_t p,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    stable_filter{m,p,h,al}
+  {
+    insert(first,last);
+  }
+
+  stable_filter(
+    std::initializer_list<value_type> il,
+    std::size_t m,std::size_t p,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    stable_filter{il.begin(),il.end(),m,p,h,al}{}
+
+  stable_filter(const stable_filter&)=default;
+  stable_filter(stable_filter&&)=default;
+  stable_filter& operator=(const stable_filter&)=default;
+  stable_filter& operator=(stable_filter&&)=default;
+
+  allocator_type get_allocator()const noexcept
+  {
+    return core.get_allocator();
+  }
+
+  std::size_t capacity()const noexcept
+  {
+    return core.capacity();
+  }
+
+  std::size_t cell_count()const noexcept
+  {
+    return core.capacity()/CellWidth;
+  }
+
+  std::size_t decrements()const noexcept
+  {
+    return decrements_;
+  }
+
+  double fpr()const noexcept
+  {
+    return fpr_for(decrements_);
+  }
+
+  /* Stationary FPR as given by Deng and Rafiei: the fraction of zero cells
+   * converges to (1+1/(p*(1/K-1/m)))^-max, m being here the number of
+   * cells of a block, as decrements don't leave it.
+   */
+
+  static double fpr_for(std::size_t p)noexcept
+  {
+    if(p==0)return 1.0;
+    double x=1.0/(double)k-1.0/(double)num_cells;
+    double zeros=std::pow(1.0+1.0/((double)p*x),-(double)max_cell);
+    return std::pow(1.0-zeros,(double)k);
+  }
+
+  /* smallest p with fpr_for(p)<=fpr, capped at max_decrements */
+
+  static std::size_t decrements_for(double fpr)noexcept
+  {
+    BOOST_ASSERT(fpr>=0.0&&fpr<=1.0);
+    if(fpr>=1.0)return 0;
+
+    double zeros=1.0-std::pow(fpr,1.0/(double)k),
+           q=std::pow(zeros,1.0/(double)max_cell);
+    if(!(q<1.0))return max_decrements;
+    double x=1.0/(double)k-1.0/(double)num_cells,
+           p=std::ceil(q/((1.0-q)*x));
+    if(!(p<(double)max_decrements))return max_decrements;
+
+    /* correct rounding errors */
+    std::size_t res=p<1.0?1:(std::size_t)p;
+    while(res>1&&fpr_for(res-1)<=fpr)--res;
+    while(res<max_decrements&&fpr_for(res)>fpr)++res;
+    return res;
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  /* Blocks of the next bulk_insert_size elements are prefetched while the
+   * current one is updated. Elements are processed in order, so the result
+   * is the same as with one-by-one insertion.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    if(!capacity())return;
+
+    std::uint64_t  hashes[bulk_insert_size];
+    unsigned char* positions[bulk_insert_size];
+    std::size_t    n=0;
+    for(;n<bulk_insert_size&&first!=last;++first,++n){
+      auto& hash=hashes[n]=hash_for(*first);
+      positions[n]=core.start_insert(hash);
+    }
+    std::size_t i=0;
+    for(;first!=last;++first){
+      set(positions[i],hashes[i]);
+      auto& hash=hashes[i]=hash_for(*first);
+      positions[i]=core.start_insert(hash);
+      if(++i==bulk_insert_size)i=0;
+    }
+    for(std::size_t j=0;j<n;++j){
+      set(positions[i],hashes[i]);
+      if(++i==bulk_insert_size)i=0;
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void swap(stable_filter& x)
+    noexcept(noexcept(std::declval<core_type&>().swap(
+      std::declval<core_type&>())))
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    using std::swap;
+
+    core.swap(x.core);
+    swap(h(),x.h());
+    swap(decrements_,x.decrements_);
+    swap(rnd,x.rnd);
+  }
+
+  void clear()noexcept
+  {
+    core.clear();
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<typename ForwardIterator,typename F>
+  void may_contain(ForwardIterator first,ForwardIterator last,F f)const
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_FORWARD_ITERATOR(ForwardIterator);
+
+    if(!capacity()){
+      for(;first!=last;++first)f(*first,true);
+      return;
+    }
+    core.bulk_may_contain(
+      [this,first]()mutable{return hash_for(*first++);},
+      static_cast<std::size_t>(std::distance(first,last)),
+      [&f,first](bool res)mutable{f(*first++,res);});
+  }
+
+private:
+  template<typename T1,std::size_t K1,std::size_t C1,typename H1,typename A1>
+  bool friend operator==(
+    const stable_filter<T1,K1,C1,H1,A1>& x,
+    const stable_filter<T1,K1,C1,H1,A1>& y);
+
+  using hash_base=empty_value<Hash,0>;
+  using block_value_type=typename block_type::value_type;
+  static constexpr std::size_t   num_cells=block_type::num_cells;
+  static constexpr std::uint64_t max_cell=block_type::max_cell;
+  static constexpr std::size_t   max_decrements=num_cells*max_cell;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+
+  template<typename U>
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    if(!capacity())return;
+    auto p=core.start_insert(hash);
+    set(p,hash);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    return !capacity()||core.may_contain(hash);
+  }
+
+  /* The start of decrement runs comes from a Weyl sequence scrambled with
+   * mulx64 rather than from the hash so that repeated insertions of the
+   * same element don't keep hitting the same cells.
+   */
+
+  BOOST_FORCEINLINE void set(unsigned char* p,std::uint64_t hash)
+  {
+    auto& x=*reinterpret_cast<block_value_type*>(p);
+    rnd+=0xf1357aea2e62a9c5ull;
+    block_type::decrement(x,decrements_,detail::mulx64(rnd));
+    block_type::mark(x,hash);
+  }
+
+  core_type     core;
+  std::size_t   decrements_;
+  std::uint64_t rnd=0;
+};
+
+template<typename T,std::size_t K,std::size_t C,typename H,typename A>
+bool operator==(
+  const stable_filter<T,K,C,H,A>& x,const stable_filter<T,K,C,H,A>& y)
+{
+  return x.core==y.core;
+}
+
+template<typename T,std::size_t K,std::size_t C,typename H,typename A>
+bool operator!=(
+  const stable_filter<T,K,C,H,A>& x,const stable_filter<T,K,C,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,std::size_t K,std::size_t C,typename H,typename A>
+void swap(stable_filter<T,K,C,H,A>& x,stable_filter<T,K,C,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
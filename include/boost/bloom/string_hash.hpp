@@ -0,0 +1,161 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_STRING_HASH_HPP
+#define BOOST_BLOOM_STRING_HASH_HPP
+
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+#include <string_view>
+#endif
+
+namespace boost{
+namespace bloom{
+
+namespace detail{
+
+/* wyhash final version 4.2 by Wang Yi, released into the public domain.
+ * https://github.com/wangyi-fudan/wyhash
+ * Reads are done in native byte order, so results are not portable
+ * across platforms with different endianness.
+ */
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t wyhash_mix(std::uint64_t a,std::uint64_t b)noexcept
+{
+  std::uint64_t hi;
+  std::uint64_t lo=umul128(a,b,hi);
+  return hi^lo;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t wyhash_read64(const unsigned char* p)noexcept
+{
+  std::uint64_t x;
+  std::memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t wyhash_read32(const unsigned char* p)noexcept
+{
+  std::uint32_t x;
+  std::memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t wyhash(
+  const void* data,std::size_t len,std::uint64_t seed)noexcept
+{
+  static constexpr std::uint64_t secret[]={
+    0x2d358dccaa6c78a5ull,0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull,0x4d5a2da51de1aa47ull
+  };
+
+  auto          p=static_cast<const unsigned char*>(data);
+  std::uint64_t a,b;
+
+  seed^=wyhash_mix(seed^secret[0],secret[1]);
+  if(BOOST_LIKELY(len<=16)){
+    if(BOOST_LIKELY(len>=4)){
+      std::size_t offset=(len>>3)<<2;
+      a=(wyhash_read32(p)<<32)|wyhash_read32(p+offset);
+      b=(wyhash_read32(p+len-4)<<32)|wyhash_read32(p+len-4-offset);
+    }
+    else if(BOOST_LIKELY(len>0)){
+      a=((std::uint64_t)p[0]<<16)|((std::uint64_t)p[len>>1]<<8)|p[len-1];
+      b=0;
+    }
+    else a=b=0;
+  }
+  else{
+    std::size_t i=len;
+    if(BOOST_UNLIKELY(i>48)){
+      std::uint64_t see1=seed,see2=seed;
+      do{
+        seed=wyhash_mix(
+          wyhash_read64(p)^secret[1],wyhash_read64(p+8)^seed);
+        see1=wyhash_mix(
+          wyhash_read64(p+16)^secret[2],wyhash_read64(p+24)^see1);
+        see2=wyhash_mix(
+          wyhash_read64(p+32)^secret[3],wyhash_read64(p+40)^see2);
+        p+=48;
+        i-=48;
+      }while(BOOST_LIKELY(i>48));
+      seed^=see1^see2;
+    }
+    while(BOOST_UNLIKELY(i>16)){
+      seed=wyhash_mix(wyhash_read64(p)^secret[1],wyhash_read64(p+8)^seed);
+      p+=16;
+      i-=16;
+    }
+    a=wyhash_read64(p+i-16);
+    b=wyhash_read64(p+i-8);
+  }
+  a^=secret[1];
+  b^=seed;
+  a=umul128(a,b,b);
+  return wyhash_mix(a^secret[0]^len,b^secret[1]);
+}
+
+} /* namespace detail */
+
+/* Fast, avalanching hash function for strings. Being transparent, it
+ * allows for heterogeneous insertion and lookup of string views and
+ * C strings into filters of std::string without creating temporary strings.
+ */
+
+class string_hash
+{
+public:
+  using is_transparent=void;
+  using is_avalanching=std::true_type;
+
+  string_hash()=default;
+  explicit string_hash(std::uint64_t seed_)noexcept:seed{seed_}{}
+
+  template<typename Traits,typename Allocator>
+  std::size_t operator()(
+    const std::basic_string<char,Traits,Allocator>& x)const noexcept
+  {
+    return hash(x.data(),x.size());
+  }
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+  template<typename Traits>
+  std::size_t operator()(std::basic_string_view<char,Traits> x)const noexcept
+  {
+    return hash(x.data(),x.size());
+  }
+#endif
+
+  std::size_t operator()(const char* x)const noexcept
+  {
+    return hash(x,std::strlen(x));
+  }
+
+  std::size_t hash(const char* p,std::size_t n)const noexcept
+  {
+    return (std::size_t)detail::wyhash(p,n,seed);
+  }
+
+private:
+  std::uint64_t seed=0;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
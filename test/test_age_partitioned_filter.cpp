@@ -0,0 +1,161 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/age_partitioned_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_age_partitioned_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  static constexpr std::size_t k=filter::k,
+                               l=filter::l,
+                               g=2000;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          fresh;
+  for(std::size_t i=0;i<(k+l+4)*g-1;++i)input.push_back(fac());
+  for(int i=0;i<20000;++i)fresh.push_back(fac());
+
+  std::size_t m=filter::capacity_for(g);
+  BOOST_TEST_EQ(filter::capacity_for(0),0);
+  BOOST_TEST_GE(m,(k+l)*g);
+  BOOST_TEST_EQ(filter::fpr_for(g,0),1.0);
+  BOOST_TEST_LT(filter::fpr_for(g,m),filter::fpr_for(2*g,m));
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0);
+    BOOST_TEST_EQ(f.generation_size(),0);
+    f.insert(input.begin(),input.end());
+    f.insert(input[0]);
+    f.shift();
+    BOOST_TEST(f.may_contain(input[0]));
+    f.may_contain(
+      input.begin(),input.end(),
+      [](const value_type&,bool res){BOOST_TEST(res);});
+  }
+  {
+    filter f(m,g);
+    BOOST_TEST_GE(f.capacity(),m);
+    BOOST_TEST_EQ(f.generation_size(),g);
+
+    /* the last l generations are remembered */
+
+    for(std::size_t i=0;i<input.size();++i){
+      f.insert(input[i]);
+      BOOST_TEST(f.may_contain(input[i]));
+      if(i%g==g-1){
+        for(std::size_t j=(i+1>l*g?i+1-l*g:0);j<=i;++j){
+          BOOST_TEST(f.may_contain(input[j]));
+        }
+      }
+    }
+
+    /* FPR is highest right before a shift, as is the case here */
+
+    double      fpr=filter::fpr_for(g,f.capacity());
+    std::size_t fp=0,old=0;
+    for(const auto& x:fresh)fp+=f.may_contain(x);
+    BOOST_TEST_LE((double)fp/fresh.size(),1.5*fpr+0.002);
+    BOOST_TEST_GE((double)fp/fresh.size(),0.5*fpr-0.002);
+
+    /* elements older than k+l generations are completely forgotten */
+
+    for(std::size_t i=0;i<3*g;++i)old+=f.may_contain(input[i]);
+    BOOST_TEST_LE((double)old/(3*g),1.5*fpr+0.002);
+
+    std::size_t i=0;
+    f.may_contain(
+      input.begin(),input.end(),
+      [&](const value_type& x,bool res){
+        BOOST_TEST(x==input[i++]);
+        BOOST_TEST_EQ(res,f.may_contain(x));
+      });
+    BOOST_TEST_EQ(i,input.size());
+  }
+  {
+    /* bulk and one-by-one insertion are equivalent, shifts included */
+
+    for(std::size_t n:{
+      (std::size_t)0,(std::size_t)1,
+      (std::size_t)filter::bulk_insert_size+1,g,input.size()}){
+      filter f1(input.begin(),input.begin()+n,m,g),
+             f2(m,g);
+      for(std::size_t i=0;i<n;++i)f2.insert(input[i]);
+      BOOST_TEST(f1==f2);
+    }
+  }
+  {
+    /* manual shifting */
+
+    filter f(m);
+    f.insert(input.begin(),input.begin()+g);
+    for(std::size_t i=0;i<l;++i)f.shift();
+    for(std::size_t i=0;i<g;++i)BOOST_TEST(f.may_contain(input[i]));
+    for(std::size_t i=l;i<k+l;++i)f.shift();
+    BOOST_TEST(f==filter(m));
+  }
+  {
+    filter f1(input.begin(),input.end(),m,g),
+           f2(f1),
+           f3(std::move(f2));
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(f2.capacity(),0);
+    f2=f1;
+    BOOST_TEST(f2==f1);
+    f3=filter(fresh.begin(),fresh.end(),m,g);
+    BOOST_TEST(f3!=f1);
+    swap(f2,f3);
+    BOOST_TEST(f3==f1);
+    f2=std::move(f3);
+    BOOST_TEST(f2==f1);
+    f2.clear();
+    BOOST_TEST(f2==filter(m,g));
+    BOOST_TEST_EQ(f2.generation_size(),g);
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::age_partitioned_filter<int,4,3>,
+  boost::bloom::age_partitioned_filter<std::string,10,7>,
+  boost::bloom::age_partitioned_filter<std::size_t,1,1>,
+  boost::bloom::age_partitioned_filter<std::uint64_t,40,24>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_age_partitioned_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
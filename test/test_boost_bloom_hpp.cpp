@@ -16,6 +16,19 @@ struct use_types
   using type3=boost::bloom::multiblock<unsigned char,1>;
   using type4=boost::bloom::fast_multiblock32<1>;
   using type5=boost::bloom::fast_multiblock64<1>;
+  using type6=boost::bloom::sharded_filter<int,1>;
+  using type7=boost::bloom::cascaded_filter<int,1>;
+  using type8=boost::bloom::string_hash;
+  using type9=boost::bloom::sectorized_block<unsigned char,1,1>;
+  using type10=boost::bloom::ribbon_filter<int>;
+  using type11=boost::bloom::quotient_filter<int>;
+  using type12=boost::bloom::iblt<int>;
+  using type13=boost::bloom::count_min_sketch<int>;
+  using type14=boost::bloom::stable_filter<int,3>;
+  using type15=boost::bloom::age_partitioned_filter<int,4,3>;
+  using type16=boost::bloom::range_filter<int,3>;
+  using type17=boost::bloom::filter_bank<int,3>;
+  using type18=boost::bloom::filter_arena<int,3>;
 };
 
 int main()
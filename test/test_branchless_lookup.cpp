@@ -0,0 +1,58 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#define BOOST_BLOOM_BRANCHLESS_LOOKUP_THRESHOLD 0 /* always branchless */
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_branchless_lookup()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+
+  for(std::size_t m:{0,1000,100000}){
+    filter f(m);
+    f.insert(input.begin(),input.begin()+input.size()/2);
+
+    std::size_t n=0;
+    f.may_contain(input.begin(),input.end(),[&](value_type& x,bool res){
+      BOOST_TEST_EQ(res,f.may_contain(x));
+      ++n;
+    });
+    BOOST_TEST_EQ(n,input.size());
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_branchless_lookup<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
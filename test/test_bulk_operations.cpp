@@ -10,6 +10,7 @@
 #include <boost/core/lightweight_test.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <utility>
+#include <vector>
 #include "test_types.hpp"
 #include "test_utilities.hpp"
 
@@ -30,15 +31,76 @@ void test_bulk_operations()
     f2.insert(
       make_input_iterator(input.begin()),make_input_iterator(input.end()));
     BOOST_TEST(f1==f2);
+
+    filter      f3(f1.capacity());
+    std::size_t i=0,calls=0;
+    f3.insert_from([&]()->const value_type*{
+      ++calls;
+      return i<input.size()?&input[i++]:nullptr;
+    });
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(calls,input.size()+1);
   }
   {
-    Filter                      f(10000);
-    std::array<value_type,1000> input;
-    for(auto& x:input)x=fac();
-    for(std::size_t i=0;i<input.size()/2;++i)f.insert(input[i]);
-    f.may_contain(input.begin(),input.end(),[&](value_type& x,bool res){
-      BOOST_TEST_EQ(res,f.may_contain(x));
-    });
+    /* big enough for elements to be actually partitioned */
+
+    for(std::size_t m:{0ul,10000ul,40000000ul}){
+      filter                  f1(m),f2(m);
+      std::vector<value_type> input;
+      for(int i=0;i<100000;++i)input.push_back(fac());
+      f1.insert(input.begin(),input.end());
+      f2.partitioned_insert(input.begin(),input.end());
+      BOOST_TEST(f1==f2);
+    }
+  }
+  {
+    for(std::size_t m:{0ul,10000ul}){
+      Filter                      f(m);
+      std::array<value_type,1000> input;
+      for(auto& x:input)x=fac();
+      for(std::size_t i=0;i<input.size()/2;++i)f.insert(input[i]);
+      f.may_contain(input.begin(),input.end(),[&](value_type& x,bool res){
+        BOOST_TEST_EQ(res,f.may_contain(x));
+      });
+    }
+  }
+  {
+    std::vector<filter> fs;
+    for(std::size_t i=0;i<200;++i){
+      fs.emplace_back(i%10?1000+i:0);
+      for(std::size_t j=0;j<i%5;++j)fs.back().insert(fac());
+    }
+    auto x=fac();
+    for(std::size_t i=0;i<fs.size();i+=3)fs[i].insert(x);
+    for(std::size_t n:{0,5,200}){
+      for(auto x2:{x,fac()}){
+        std::size_t i=0;
+        multi_may_contain(
+          fs.begin(),fs.begin()+n,x2,[&](const filter& f,bool res){
+            BOOST_TEST_EQ(&f,&fs[i++]);
+            BOOST_TEST_EQ(res,f.may_contain(x2));
+          });
+        BOOST_TEST_EQ(i,n);
+      }
+    }
+
+    std::array<value_type,50> input;
+    for(std::size_t i=0;i<input.size();++i){
+      input[i]=fac();
+      for(std::size_t j=i%7;j<fs.size();j+=7)fs[j].insert(input[i]);
+    }
+    for(std::size_t n:{0,5,200}){
+      std::size_t i=0;
+      multi_may_contain(
+        fs.begin(),fs.begin()+n,input.begin(),input.end(),
+        [&](const filter& f,const value_type& x,bool res){
+          BOOST_TEST_EQ(&f,&fs[i%n]);
+          BOOST_TEST_EQ(&x,&input[i/n]);
+          BOOST_TEST_EQ(res,f.may_contain(x));
+          ++i;
+        });
+      BOOST_TEST_EQ(i,n*input.size());
+    }
   }
 }
 
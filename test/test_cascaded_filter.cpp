@@ -0,0 +1,136 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/cascaded_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <climits>
+#include <stdexcept>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct cascaded_filter_for_impl;
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+struct cascaded_filter_for_impl<boost::bloom::filter<T,K,SF,S,H,A>>
+{
+  using type=boost::bloom::cascaded_filter<T,K,SF,S,H,A>;
+};
+
+template<typename Filter>
+using cascaded_filter_for=typename cascaded_filter_for_impl<Filter>::type;
+
+template<typename Filter,typename ValueFactory>
+void test_cascaded_filter()
+{
+  using filter=Filter;
+  using cascaded_filter=cascaded_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          other;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+  for(int i=0;i<2000;++i)other.push_back(fac());
+
+  {
+    cascaded_filter f;
+    BOOST_TEST_EQ(f.capacity(),0);
+    BOOST_TEST_EQ(f.front_capacity(),0);
+    f.insert(input[0]);
+    f.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(f.capacity(),0);
+  }
+  {
+    cascaded_filter f1(20000),f2(20000);
+    BOOST_TEST_GE(f1.capacity(),20000);
+    BOOST_TEST_GT(f1.front_capacity(),0);
+    BOOST_TEST_LE(f1.front_capacity(),f1.capacity()/8);
+    BOOST_TEST_GE(
+      f1.front_capacity(),20000/cascaded_filter::front_capacity_ratio);
+    for(const auto& x:input)f1.insert(x);
+    f2.insert(make_input_iterator(input.begin()),make_input_iterator(input.end()));
+    for(const auto& x:input){
+      BOOST_TEST(f1.may_contain(x));
+      BOOST_TEST(f2.may_contain(x));
+    }
+
+    /* front and main lookups do not add false positives */
+
+    filter f3(f1.capacity());
+    f3.insert(input.begin(),input.end());
+    for(const auto& x:other){
+      if(f1.may_contain(x))BOOST_TEST(f3.may_contain(x));
+      BOOST_TEST_EQ(f1.may_contain(x),f2.may_contain(x));
+    }
+
+    std::vector<value_type> mixed;
+    for(std::size_t i=0;i<input.size();++i){
+      mixed.push_back(input[i]);
+      mixed.push_back(other[i]);
+    }
+    std::size_t i=0;
+    f1.may_contain(mixed.begin(),mixed.end(),[&](const value_type& x,bool res){
+      BOOST_TEST(x==mixed[i]);
+      BOOST_TEST_EQ(res,f1.may_contain(mixed[i]));
+      ++i;
+    });
+    BOOST_TEST_EQ(i,mixed.size());
+
+    f1.clear();
+    for(const auto& x:input)BOOST_TEST(!f1.may_contain(x));
+    f1|=f2;
+    for(const auto& x:input)BOOST_TEST(f1.may_contain(x));
+    f1.reset(20000,100);
+    BOOST_TEST_THROWS(f1|=f2,std::invalid_argument);
+    BOOST_TEST_THROWS(f2&=f1,std::invalid_argument);
+    f1.reset(20000);
+    f1&=f2;
+    for(const auto& x:input)BOOST_TEST(!f1.may_contain(x));
+  }
+  {
+    /* default front array is capped at front_cache_size */
+
+    std::size_t     cap=cascaded_filter::front_cache_size*CHAR_BIT;
+    cascaded_filter f(2*cap*cascaded_filter::front_capacity_ratio);
+    BOOST_TEST_GE(f.front_capacity(),cap);
+    BOOST_TEST_LT(f.front_capacity(),2*cap);
+  }
+  {
+    /* no front array */
+
+    cascaded_filter f(20000,0);
+    BOOST_TEST_EQ(f.front_capacity(),0);
+    f.insert(input.begin(),input.end());
+    for(const auto& x:input)BOOST_TEST(f.may_contain(x));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_cascaded_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
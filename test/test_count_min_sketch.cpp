@@ -0,0 +1,181 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/count_min_sketch.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Sketch,typename ValueFactory>
+void test_count_min_sketch()
+{
+  using sketch=Sketch;
+  using value_type=typename sketch::value_type;
+  using counter_type=typename sketch::counter_type;
+
+  static constexpr std::size_t max_counter=
+    (std::numeric_limits<counter_type>::max)();
+
+  /* skewed frequencies: element i is inserted about 1000/(i+1) times */
+
+  ValueFactory                     fac;
+  std::vector<value_type>          distinct,input;
+  std::map<value_type,std::size_t> model;
+  std::mt19937_64                  rng;
+  for(int i=0;i<2000;++i)distinct.push_back(fac());
+  for(std::size_t i=0;i<distinct.size();++i){
+    for(std::size_t j=0;j<1000/(i+1)+1;++j)input.push_back(distinct[i]);
+  }
+  for(std::size_t i=input.size();i>1;--i){
+    std::swap(input[i-1],input[rng()%i]);
+  }
+  for(const auto& x:input)++model[x];
+  auto expected=[&](const value_type& x){
+    auto c=model[x];
+    return c<max_counter?c:max_counter;
+  };
+
+  {
+    sketch s;
+    BOOST_TEST_EQ(s.capacity(),0);
+    BOOST_TEST_EQ(s.counter_count(),0);
+    s.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(s.estimate(distinct[0]),max_counter);
+    s.estimate(
+      distinct.begin(),distinct.end(),
+      [&](const value_type&,std::size_t c){BOOST_TEST_EQ(c,max_counter);});
+  }
+  {
+    sketch s(input.begin(),input.end(),1000000),s2(1000000);
+    BOOST_TEST_GE(s.capacity(),1000000);
+    BOOST_TEST_EQ(
+      s.counter_count(),s.capacity()/(sizeof(counter_type)*CHAR_BIT));
+    for(const auto& x:input)s2.insert(x);
+    BOOST_TEST(s==s2);
+
+    std::size_t exact=0;
+    for(const auto& x:distinct){
+      auto c=s.estimate(x);
+      BOOST_TEST_GE(c,expected(x));
+      exact+=c==expected(x);
+    }
+    BOOST_TEST_GE(exact,distinct.size()*3/4);
+
+    std::size_t i=0;
+    s.estimate(
+      distinct.begin(),distinct.end(),
+      [&](const value_type& x,std::size_t c){
+        BOOST_TEST(x==distinct[i++]);
+        BOOST_TEST_EQ(c,s.estimate(x));
+      });
+    BOOST_TEST_EQ(i,distinct.size());
+
+    /* halving */
+
+    std::vector<std::size_t> estimates;
+    for(const auto& x:distinct)estimates.push_back(s.estimate(x));
+    s.halve();
+    for(std::size_t i=0;i<distinct.size();++i){
+      BOOST_TEST_EQ(s.estimate(distinct[i]),estimates[i]/2);
+    }
+
+    /* addition */
+
+    sketch s3(input.begin(),input.begin()+input.size()/2,1000000),
+           s4(input.begin()+input.size()/2,input.end(),1000000);
+    s3+=s4;
+    for(const auto& x:distinct)BOOST_TEST_GE(s3.estimate(x),expected(x));
+    sketch s5(1000);
+    BOOST_TEST_THROWS(s3+=s5,std::invalid_argument);
+  }
+  {
+    /* small sketch: estimates are still upper bounds */
+
+    sketch s(input.begin(),input.end(),4000);
+    for(const auto& x:distinct)BOOST_TEST_GE(s.estimate(x),expected(x));
+  }
+  {
+    /* periodic halving */
+
+    std::size_t period=1000;
+    sketch      s1(input.begin(),input.end(),100000,period),
+                s2(100000,period),
+                s3(100000);
+    BOOST_TEST_EQ(s1.halving_period(),period);
+    BOOST_TEST_EQ(s3.halving_period(),0);
+    for(const auto& x:input)s2.insert(x);
+    BOOST_TEST(s1==s2);
+
+    std::size_t n=0;
+    for(const auto& x:input){
+      s3.insert(x);
+      if(++n==period){
+        s3.halve();
+        n=0;
+      }
+    }
+    BOOST_TEST(s1==s3);
+  }
+  {
+    sketch s1(input.begin(),input.end(),100000),
+           s2(s1),
+           s3(std::move(s2));
+    BOOST_TEST(s1==s3);
+    BOOST_TEST_EQ(s2.capacity(),0);
+    s2=s1;
+    BOOST_TEST(s2==s1);
+    s3=sketch(distinct.begin(),distinct.end(),100000);
+    BOOST_TEST(s3!=s1);
+    swap(s2,s3);
+    BOOST_TEST(s3==s1);
+    s2=std::move(s3);
+    BOOST_TEST(s2==s1);
+    s2.clear();
+    BOOST_TEST(s2==sketch(100000));
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::count_min_sketch<int>,
+  boost::bloom::count_min_sketch<std::string,3,std::uint8_t>,
+  boost::bloom::count_min_sketch<std::size_t,8,std::uint16_t>,
+  boost::bloom::count_min_sketch<std::uint64_t,1,std::uint64_t>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using sketch=typename T::type;
+    using value_type=typename sketch::value_type;
+
+    test_count_min_sketch<sketch,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
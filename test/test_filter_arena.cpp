@@ -0,0 +1,219 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/filter_arena.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Arena>
+struct filter_for;
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+struct filter_for<boost::bloom::filter_arena<T,K,SF,S,H,A>>
+{
+  using type=boost::bloom::filter<T,K,SF,S,H,A>;
+};
+
+template<typename Handle>
+bool all_zero(const Handle& x)
+{
+  auto a=x.array();
+  return std::all_of(
+    a.begin(),a.end(),[](unsigned char c){return c==0;});
+}
+
+template<typename Handle,typename Filter>
+bool same_bits(const Handle& x,const Filter& f)
+{
+  auto a=x.array();
+  auto b=f.array();
+  return a.size()==b.size()&&std::equal(a.begin(),a.end(),b.begin());
+}
+
+template<typename Arena,typename ValueFactory>
+void test_filter_arena()
+{
+  using arena=Arena;
+  using filter=typename filter_for<arena>::type;
+  using handle=typename arena::handle;
+  using value_type=typename arena::value_type;
+
+  static constexpr std::size_t n=10;
+
+  ValueFactory            fac;
+  std::vector<value_type> fresh;
+  for(int i=0;i<1000;++i)fresh.push_back(fac());
+
+  BOOST_TEST_EQ(arena::capacity_for(n,0.01),filter::capacity_for(n,0.01));
+  BOOST_TEST_EQ(arena::fpr_for(n,1000),filter::fpr_for(n,1000));
+  for(std::size_t m:{(std::size_t)0,(std::size_t)1,(std::size_t)200,
+                     (std::size_t)1000,(std::size_t)1000000}){
+    BOOST_TEST_EQ(arena(m).capacity(),filter(m).capacity());
+  }
+  {
+    /* capacity 0 */
+
+    arena  a;
+    handle x=a.add({fresh[0]});
+    BOOST_TEST_EQ(a.size(),1);
+    BOOST_TEST_EQ(a.slab_count(),0);
+    BOOST_TEST_EQ(x.capacity(),0);
+    BOOST_TEST(x.may_contain(fresh[1]));
+    a.remove(x);
+    BOOST_TEST_EQ(a.size(),0);
+  }
+  {
+    arena a(n,0.01);
+    BOOST_TEST_GE(a.slot_size(),a.capacity()/CHAR_BIT);
+    BOOST_TEST_LE(
+      a.slot_size()*a.slab_capacity(),(std::size_t)arena::slab_size);
+
+    /* enough filters to span three slabs */
+
+    std::size_t                          num_filters=2*a.slab_capacity()+3;
+    std::vector<std::vector<value_type>> inputs(num_filters);
+    std::vector<handle>                  hs;
+    for(auto& input:inputs){
+      for(std::size_t i=0;i<n;++i)input.push_back(fac());
+      hs.push_back(a.add(input.begin(),input.end()));
+    }
+    BOOST_TEST_EQ(a.size(),num_filters);
+    BOOST_TEST_EQ(a.slab_count(),3);
+
+    /* same bits as filter */
+
+    for(std::size_t j=0;j<num_filters;++j){
+      BOOST_TEST_EQ(hs[j].capacity(),a.capacity());
+      for(const auto& x:inputs[j])BOOST_TEST(hs[j].may_contain(x));
+      if(j%97==0){
+        filter f(inputs[j].begin(),inputs[j].end(),a.capacity());
+        BOOST_TEST(same_bits(hs[j],f));
+        std::size_t fp1=0,fp2=0;
+        for(const auto& x:fresh){
+          fp1+=hs[j].may_contain(x);
+          fp2+=f.may_contain(x);
+        }
+        BOOST_TEST_EQ(fp1,fp2);
+      }
+    }
+
+    /* filters don't overlap */
+
+    for(std::size_t j=1;j<num_filters;++j){
+      auto p=hs[j-1].array().data(),q=hs[j].array().data();
+      BOOST_TEST(p+hs[j-1].array().size()<=q||q+hs[j].array().size()<=p);
+    }
+
+    /* removed slots are reused, last removed first */
+
+    a.remove(hs[5]);
+    a.remove(hs[num_filters-1]);
+    BOOST_TEST_EQ(a.size(),num_filters-2);
+    handle x=a.add(),y=a.add(),z=a.add();
+    BOOST_TEST_EQ(x.array().data(),hs[num_filters-1].array().data());
+    BOOST_TEST_EQ(y.array().data(),hs[5].array().data());
+    BOOST_TEST(all_zero(x));
+    BOOST_TEST(all_zero(y));
+    BOOST_TEST_EQ(a.slab_count(),3);
+    hs[5]=y;
+    hs[num_filters-1]=x;
+    hs.push_back(z);
+    for(std::size_t j=0;j<num_filters;++j){
+      if(j==5||j==num_filters-1)continue;
+      for(const auto& x2:inputs[j])BOOST_TEST(hs[j].may_contain(x2));
+    }
+
+    /* handles survive moving the arena */
+
+    arena a2(std::move(a));
+    BOOST_TEST_EQ(a.size(),0);
+    BOOST_TEST_EQ(a.slab_count(),0);
+    BOOST_TEST_EQ(a2.size(),num_filters+1);
+    for(const auto& x2:inputs[0])BOOST_TEST(hs[0].may_contain(x2));
+    a=std::move(a2);
+    swap(a,a2);
+    BOOST_TEST_EQ(a2.size(),num_filters+1);
+
+    /* bulk clear */
+
+    a2.clear();
+    BOOST_TEST_EQ(a2.size(),num_filters+1);
+    for(const auto& h:hs)BOOST_TEST(all_zero(h));
+    hs[0].insert(inputs[0].begin(),inputs[0].end());
+    for(const auto& x2:inputs[0])BOOST_TEST(hs[0].may_contain(x2));
+
+    /* bulk release: slabs are reused from the first one */
+
+    auto first_slot=hs[0].array().data();
+    a2.reset();
+    BOOST_TEST_EQ(a2.size(),0);
+    BOOST_TEST_EQ(a2.slab_count(),3);
+    hs.clear();
+    for(std::size_t j=0;j<num_filters;++j)hs.push_back(a2.add());
+    BOOST_TEST_EQ(hs[0].array().data(),first_slot);
+    BOOST_TEST_EQ(a2.slab_count(),3);
+    for(const auto& h:hs)BOOST_TEST(all_zero(h));
+  }
+  {
+    arena a(n,0.01);
+    a.reserve(a.slab_capacity()+1);
+    BOOST_TEST_EQ(a.slab_count(),2);
+    a.reserve(1);
+    BOOST_TEST_EQ(a.slab_count(),2);
+    for(std::size_t j=0;j<2*a.slab_capacity();++j)a.add();
+    BOOST_TEST_EQ(a.slab_count(),2);
+    a.add();
+    BOOST_TEST_EQ(a.slab_count(),3);
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::filter_arena<int,5>,
+  boost::bloom::filter_arena<
+    std::string,1,boost::bloom::block<std::uint64_t,5>>,
+  boost::bloom::filter_arena<
+    std::size_t,2,boost::bloom::multiblock<std::uint32_t,3>,1>,
+  boost::bloom::filter_arena<
+    std::uint64_t,1,boost::bloom::fast_multiblock32<5>>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using arena=typename T::type;
+    using value_type=typename arena::value_type;
+
+    test_filter_arena<arena,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,205 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter_bank.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Bank>
+std::vector<std::size_t> matches(
+  const Bank& b,const typename Bank::value_type& x)
+{
+  std::vector<std::size_t> res;
+  b.match(x,[&](std::size_t i){res.push_back(i);});
+  return res;
+}
+
+template<typename Bank,typename ValueFactory>
+void test_filter_bank()
+{
+  using bank=Bank;
+  using value_type=typename bank::value_type;
+
+  static constexpr std::size_t num_members=600,
+                               n=50;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          fresh;
+  for(std::size_t i=0;i<num_members*n;++i)input.push_back(fac());
+  for(int i=0;i<2000;++i)fresh.push_back(fac());
+  auto first=[&](std::size_t j){return input.begin()+j*n;};
+
+  std::size_t m=bank::capacity_for(n,0.01);
+  BOOST_TEST_EQ(bank::capacity_for(0,0.01),0);
+  BOOST_TEST_LE(bank::fpr_for(n,m),0.01);
+  BOOST_TEST_GT(bank::fpr_for(n,m-1),bank::fpr_for(n,m));
+  BOOST_TEST_EQ(bank::fpr_for(n,0),1.0);
+  {
+    /* capacity 0: all members may contain anything */
+
+    bank b;
+    BOOST_TEST_EQ(b.capacity(),0);
+    BOOST_TEST_EQ(b.size(),0);
+    BOOST_TEST(matches(b,input[0]).empty());
+    std::size_t i0=b.add(first(0),first(1)),
+                i1=b.add();
+    BOOST_TEST_EQ(i0,0);
+    BOOST_TEST_EQ(i1,1);
+    b.insert(i1,input[0]);
+    BOOST_TEST(b.may_contain(i1,input[0]));
+    BOOST_TEST(matches(b,fresh[0])==(std::vector<std::size_t>{0,1}));
+  }
+  {
+    bank b(n,0.01);
+    BOOST_TEST_EQ(b.capacity(),m);
+    for(std::size_t j=0;j<num_members;++j){
+      BOOST_TEST_EQ(b.add(first(j),first(j+1)),j);
+    }
+    BOOST_TEST_EQ(b.size(),num_members);
+    BOOST_TEST_GE(b.member_capacity(),num_members);
+
+    /* no false negatives, match consistent with may_contain */
+
+    for(std::size_t j=0;j<num_members;++j){
+      for(auto it=first(j);it!=first(j+1);++it){
+        BOOST_TEST(b.may_contain(j,*it));
+      }
+    }
+    for(std::size_t i=0;i<input.size();i+=7){
+      std::vector<std::size_t> res1=matches(b,input[i]),res2;
+      for(std::size_t j=0;j<num_members;++j){
+        if(b.may_contain(j,input[i]))res2.push_back(j);
+      }
+      BOOST_TEST(res1==res2);
+    }
+
+    /* FPR */
+
+    std::size_t fp=0;
+    for(const auto& x:fresh)fp+=matches(b,x).size();
+    BOOST_TEST_LE(
+      (double)fp/(fresh.size()*num_members),1.5*b.fpr_for(n,m)+0.002);
+
+    /* match_all is the intersection of matches */
+
+    for(std::size_t i=0;i+1<input.size();i+=101){
+      std::vector<std::size_t> res1,res2,
+                               m1=matches(b,input[i]),
+                               m2=matches(b,input[i+1]);
+      b.match_all(
+        input.begin()+i,input.begin()+i+2,
+        [&](std::size_t j){res1.push_back(j);});
+      for(auto j:m1){
+        for(auto j2:m2)if(j==j2)res2.push_back(j);
+      }
+      BOOST_TEST(res1==res2);
+    }
+    std::size_t all=0;
+    b.match_all(input.begin(),input.begin(),[&](std::size_t){++all;});
+    BOOST_TEST_EQ(all,num_members);
+
+    /* batch and one-by-one removal are equivalent */
+
+    std::vector<std::size_t> removed;
+    for(std::size_t j=1;j<num_members;j+=3)removed.push_back(j);
+    bank b2(b);
+    b.remove(removed.begin(),removed.end());
+    for(auto j:removed)b2.remove(j);
+    BOOST_TEST(b==b2);
+    BOOST_TEST_EQ(b.size(),num_members-removed.size());
+    for(std::size_t j=0;j<num_members;++j){
+      BOOST_TEST_EQ(b.is_member(j),j%3!=1);
+    }
+    for(auto j:removed){
+      for(auto i:matches(b,*first(j)))BOOST_TEST_NE(i,j);
+    }
+
+    /* removed slots are reused, lowest first, and start empty */
+
+    std::vector<std::size_t> added;
+    b.add(2,std::back_inserter(added));
+    BOOST_TEST(added==(std::vector<std::size_t>{1,4}));
+    for(auto i:matches(b,*first(1)))BOOST_TEST_NE(i,1);
+    b.insert(1,first(1),first(2));
+    BOOST_TEST(b.may_contain(1,*first(1)));
+  }
+  {
+    /* bulk and one-by-one insertion are equivalent */
+
+    bank b1(m),b2(m);
+    b1.reserve(1000);
+    BOOST_TEST_GE(b1.member_capacity(),1000);
+    for(std::size_t j=0;j<70;++j){
+      b1.add(first(j),first(j+1));
+      b2.add();
+      for(auto it=first(j);it!=first(j+1);++it)b2.insert(j,*it);
+    }
+    BOOST_TEST(b1==b2);
+    b2.insert(69,fresh[0]);
+    BOOST_TEST(b1!=b2);
+    BOOST_TEST(bank(m)!=bank(m+1));
+  }
+  {
+    bank b1(m),b2,b3;
+    for(std::size_t j=0;j<100;++j)b1.add(first(j),first(j+1));
+    b2=b1;
+    b3=std::move(b2);
+    BOOST_TEST(b1==b3);
+    BOOST_TEST_EQ(b2.capacity(),0);
+    BOOST_TEST_EQ(b2.size(),0);
+    bank b4(b3),b5(std::move(b4));
+    BOOST_TEST(b5==b1);
+    b4=bank(m);
+    b4.add(fresh.begin(),fresh.end());
+    swap(b4,b5);
+    BOOST_TEST(b4==b1);
+    BOOST_TEST_EQ(b5.size(),1);
+    b4.clear();
+    BOOST_TEST_EQ(b4.size(),0);
+    BOOST_TEST(b4==bank(m));
+    BOOST_TEST_EQ(b4.add(),0);
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::filter_bank<int,5>,
+  boost::bloom::filter_bank<std::string,3>,
+  boost::bloom::filter_bank<std::size_t,1>,
+  boost::bloom::filter_bank<std::uint64_t,9>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using bank=typename T::type;
+    using value_type=typename bank::value_type;
+
+    test_filter_bank<bank,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
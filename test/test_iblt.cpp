@@ -0,0 +1,183 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/iblt.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+struct triple
+{
+  std::uint32_t a;
+  std::uint32_t c;
+  std::uint64_t b;
+
+  friend bool operator==(const triple& x,const triple& y)
+  {
+    return x.a==y.a&&x.b==y.b&&x.c==y.c;
+  }
+
+  friend bool operator<(const triple& x,const triple& y)
+  {
+    return x.a<y.a;
+  }
+
+  friend std::size_t hash_value(const triple& x)
+  {
+    return boost::hash<std::uint64_t>()(x.a^x.b^((std::uint64_t)x.c<<32));
+  }
+};
+
+namespace test_utilities{
+
+template<>
+struct value_factory<triple>
+{
+  triple operator()()
+  {
+    ++n;
+    return {n,n%1000,(std::uint64_t)n*n};
+  }
+
+  std::uint32_t n=0;
+};
+
+}
+
+template<typename Table,typename ValueFactory>
+void test_iblt()
+{
+  using table=Table;
+  using value_type=typename table::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> common,
+                          only1,
+                          only2;
+  for(int i=0;i<20000;++i)common.push_back(fac());
+  for(int i=0;i<10000;++i)only1.push_back(fac());
+  for(int i=0;i<10000;++i)only2.push_back(fac());
+
+  auto sorted=[](std::vector<value_type> v){
+    std::sort(v.begin(),v.end());
+    return v;
+  };
+
+  {
+    table t;
+    BOOST_TEST_EQ(t.cell_count(),0);
+    BOOST_TEST_EQ(t.capacity(),0);
+    t.insert(common.begin(),common.end());
+    std::vector<value_type> pos,neg;
+    BOOST_TEST(t.decode(std::back_inserter(pos),std::back_inserter(neg)));
+    BOOST_TEST(pos.empty());
+    BOOST_TEST(neg.empty());
+  }
+  for(std::size_t d:{1,2,10,100,1000,10000}){
+    std::size_t d1=d/2,d2=d-d1;
+    table       t1(d),t2(d);
+    BOOST_TEST_EQ(t1.cell_count(),table::cell_count_for(d));
+    BOOST_TEST_EQ(t1.cell_count()%table::k,0);
+    BOOST_TEST_GT(t1.cell_count(),d);
+    BOOST_TEST_LE(t1.cell_count(),table::cell_count_for(d+1));
+
+    t1.insert(common.begin(),common.end());
+    t1.insert(only1.begin(),only1.begin()+d1);
+    for(std::size_t i=0;i<d2;++i)t2.insert(only2[i]);
+    for(const auto& x:common)t2.insert(x);
+    t1-=t2;
+
+    std::vector<value_type> pos,neg;
+    BOOST_TEST(t1.decode(std::back_inserter(pos),std::back_inserter(neg)));
+    BOOST_TEST(sorted(pos)==std::vector<value_type>(
+      only1.begin(),only1.begin()+d1));
+    BOOST_TEST(sorted(neg)==std::vector<value_type>(
+      only2.begin(),only2.begin()+d2));
+
+    /* difference much larger than expected */
+
+    std::size_t d3=(std::min)(10*d+100,only1.size());
+    table       t3(d3/10);
+    t3.insert(only1.begin(),only1.begin()+d3);
+    pos.clear();
+    neg.clear();
+    BOOST_TEST(!t3.decode(std::back_inserter(pos),std::back_inserter(neg)));
+    BOOST_TEST(neg.empty());
+    BOOST_TEST_LE(pos.size(),d3);
+  }
+  {
+    table t1(100),t2(100);
+    t1.insert(common.begin(),common.end());
+    for(const auto& x:common)t1.erase(x);
+    BOOST_TEST(t1==t2);
+
+    t1.insert(only1.begin(),only1.end());
+    for(const auto& x:only1)t2.insert(x);
+    BOOST_TEST(t1==t2);
+    t1.erase(only1.begin(),only1.end());
+    t2.clear();
+    BOOST_TEST(t1==t2);
+
+    table t3(1000);
+    BOOST_TEST_THROWS(t1-=t3,std::invalid_argument);
+  }
+  {
+    table t1(common.begin(),common.end(),100),
+          t2(t1),
+          t3(std::move(t2));
+    BOOST_TEST(t1==t3);
+    BOOST_TEST_EQ(t2.cell_count(),0);
+    t2=t1;
+    BOOST_TEST(t2==t1);
+    t3=table(only1.begin(),only1.end(),100);
+    BOOST_TEST(t3!=t1);
+    swap(t2,t3);
+    BOOST_TEST(t3==t1);
+    t2=std::move(t3);
+    BOOST_TEST(t2==t1);
+    t2-=t1;
+    BOOST_TEST(t2==table(100));
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::iblt<int>,
+  boost::bloom::iblt<std::uint64_t,3>,
+  boost::bloom::iblt<triple,5>,
+  boost::bloom::iblt<std::uint32_t,8>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using table=typename T::type;
+    using value_type=typename table::value_type;
+
+    test_iblt<table,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,126 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <array>
+#include <boost/bloom/lookup_pipeline.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstddef>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Input>
+struct result_recorder
+{
+  void operator()(std::size_t i,bool res)
+  {
+    BOOST_TEST_LT(i,results->size());
+    BOOST_TEST_EQ((*results)[i],-1);
+    (*results)[i]=res;
+  }
+
+  std::vector<int>* results;
+};
+
+template<typename Filter,typename Input>
+struct resubmitter
+{
+  void operator()(std::size_t i,bool res)
+  {
+    BOOST_TEST_EQ((*results)[i],-1);
+    (*results)[i]=res;
+    if(i%2==0)p->may_contain((*input)[i+1],i+1);
+  }
+
+  boost::bloom::lookup_pipeline<Filter,std::size_t,resubmitter>* p;
+  const Input*                                                  input;
+  std::vector<int>*                                             results;
+};
+
+template<typename Filter,typename ValueFactory>
+void test_lookup_pipeline()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+  using input_type=std::array<value_type,1000>;
+
+  ValueFactory fac;
+  filter       f(10000);
+  input_type   input;
+  for(auto& x:input)x=fac();
+  for(std::size_t i=0;i<input.size()/2;++i)f.insert(input[i]);
+
+  {
+    using pipeline=boost::bloom::lookup_pipeline<
+      filter,std::size_t,result_recorder<input_type>>;
+
+    const std::size_t depth=pipeline::depth;
+    std::vector<int>  results(input.size(),-1);
+    {
+      pipeline p(f,{&results});
+      BOOST_TEST_EQ(&p.filter(),&f);
+      BOOST_TEST(p.empty());
+      for(std::size_t i=0;i<input.size();++i){
+        p.may_contain(input[i],i);
+        BOOST_TEST_EQ(p.size(),i<depth?i+1:depth);
+      }
+      p.flush();
+      BOOST_TEST(p.empty());
+      for(std::size_t i=0;i<input.size();++i){
+        BOOST_TEST_EQ(results[i],(int)f.may_contain(input[i]));
+      }
+
+      std::fill(results.begin(),results.end(),-1);
+      for(std::size_t i=0;i<input.size();++i)p.may_contain(input[i],i);
+    }
+    for(std::size_t i=0;i<input.size();++i){ /* destructor flushes */
+      BOOST_TEST_EQ(results[i],(int)f.may_contain(input[i]));
+    }
+  }
+  {
+    /* handler submits new lookups from within the pipeline */
+
+    using handler=resubmitter<filter,input_type>;
+    using pipeline=boost::bloom::lookup_pipeline<filter,std::size_t,handler>;
+
+    const std::size_t depth=pipeline::depth;
+    std::vector<int>  results(input.size(),-1);
+    pipeline          p(f,{nullptr,&input,&results});
+    p.handler().p=&p;
+    for(std::size_t i=0;i<input.size();i+=2){
+      p.may_contain(input[i],i);
+      BOOST_TEST_LE(p.size(),depth);
+    }
+    p.flush();
+    BOOST_TEST(p.empty());
+    for(std::size_t i=0;i<input.size();++i){
+      BOOST_TEST_EQ(results[i],(int)f.may_contain(input[i]));
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_lookup_pipeline<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
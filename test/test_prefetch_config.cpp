@@ -0,0 +1,63 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#define BOOST_BLOOM_CACHELINE_SIZE               128
+#define BOOST_BLOOM_BULK_PREFETCH_CACHELINES     200
+#define BOOST_BLOOM_PIPELINE_PREFETCH_CACHELINES 4
+
+#include <array>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_prefetch_config()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  BOOST_TEST(filter::bulk_may_contain_size<=64);
+  BOOST_TEST(filter::bulk_may_contain_size<=filter::bulk_insert_size);
+
+  ValueFactory                fac;
+  filter                      f1(10000),f2(f1.capacity());
+  std::array<value_type,1000> input;
+  for(auto& x:input)x=fac();
+  if(alignof(typename filter::subfilter::value_type)<=128&&
+     filter::stride%alignof(typename filter::subfilter::value_type)==0){
+    BOOST_TEST_EQ((std::uintptr_t)f1.array().data()%128,0);
+  }
+  f1.insert(input.begin(),input.begin()+input.size()/2);
+  for(std::size_t i=0;i<input.size()/2;++i)f2.insert(input[i]);
+  BOOST_TEST(f1==f2);
+  f1.may_contain(input.begin(),input.end(),[&](value_type& x,bool res){
+    BOOST_TEST_EQ(res,f2.may_contain(x));
+  });
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_prefetch_config<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,412 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/quotient_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* With an avalanching identity hash, fingerprints are the high bits of the
+ * values, so counts can be checked exactly against a model.
+ */
+
+struct identity_hash
+{
+  using is_avalanching=std::true_type;
+
+  std::size_t operator()(std::uint64_t x)const noexcept
+  {
+    return (std::size_t)x;
+  }
+};
+
+template<std::size_t Bits,std::size_t MaxQuotientBits=20>
+void test_model()
+{
+  using filter=boost::bloom::quotient_filter<
+    std::uint64_t,Bits,MaxQuotientBits,identity_hash>;
+
+  std::mt19937_64                       rng;
+  filter                                f;
+  std::map<std::uint64_t,std::size_t>   model;
+  std::vector<std::uint64_t>            values;
+  const std::size_t                     fbits=f.fingerprint_bits();
+
+  auto fingerprint=[&](std::uint64_t x){return x>>(64-fbits);};
+  auto check=[&]{
+    std::size_t n=0;
+    for(const auto& p:model)n+=p.second;
+    BOOST_TEST_EQ(f.size(),n);
+    for(auto x:values)BOOST_TEST_EQ(f.count(x),model[fingerprint(x)]);
+  };
+
+  /* values crowded in a few regions to produce long clusters, and with a
+   * small number of distinct fingerprints to produce repetitions
+   */
+
+  for(int i=0;i<4000;++i){
+    std::uint64_t x=rng();
+    if(i%3==0)x=(x&0x00FFFFFFFFFFFFFFull)|(rng()%4<<62);
+    if(i%5==0&&!values.empty())x=values[rng()%values.size()]^(rng()&0xFF);
+    values.push_back(x);
+  }
+  for(int i=0;i<20000;++i){
+    auto x=values[rng()%values.size()];
+    auto& c=model[fingerprint(x)];
+    if(rng()%3==0){
+      if(c){
+        BOOST_TEST(f.erase(x));
+        --c;
+      }
+    }
+    else{
+      BOOST_TEST(f.insert(x));
+      ++c;
+    }
+    if(i%2000==0)check();
+  }
+  check();
+  BOOST_TEST_GT(f.slot_count(),64u);
+  BOOST_TEST_EQ(f.fingerprint_bits(),fbits);
+
+  /* table layout does not depend on the order of insertion */
+
+  filter f2(f);
+  f2.clear();
+  for(auto it=model.rbegin();it!=model.rend();++it){
+    for(std::size_t i=0;i<it->second;++i){
+      f2.insert(it->first<<(64-fbits));
+    }
+  }
+  BOOST_TEST(f2==f);
+
+  for(const auto& p:model){
+    for(std::size_t i=0;i<p.second;++i){
+      BOOST_TEST(f.erase(p.first<<(64-fbits)));
+    }
+  }
+  model.clear();
+  check();
+  BOOST_TEST(f.empty());
+  for(auto x:values)BOOST_TEST(!f.may_contain(x));
+  BOOST_TEST(!f.erase(values[0]));
+}
+
+template<typename Filter,typename ValueFactory>
+void test_quotient_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          other;
+  for(int i=0;i<20000;++i)input.push_back(fac());
+  for(int i=0;i<50000;++i)other.push_back(fac());
+
+  {
+    filter f;
+    BOOST_TEST(f.empty());
+    BOOST_TEST_EQ(f.size(),0);
+    BOOST_TEST_EQ(f.capacity(),0);
+    BOOST_TEST_EQ(
+      f.fingerprint_bits(),
+      (std::size_t)(filter::max_quotient_bits+filter::bits));
+    for(const auto& x:input){
+      BOOST_TEST(!f.may_contain(x));
+      BOOST_TEST_EQ(f.count(x),0);
+      BOOST_TEST(!f.erase(x));
+    }
+    f.may_contain(input.begin(),input.end(),[](const value_type&,bool res){
+      BOOST_TEST(!res);
+    });
+    f.count(input.begin(),input.end(),[](const value_type&,std::size_t res){
+      BOOST_TEST_EQ(res,0);
+    });
+  }
+  {
+    filter f(input.size());
+    auto   slots=f.slot_count();
+    BOOST_TEST_GE(slots-slots/10,input.size());
+    f.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(f.slot_count(),slots);
+    BOOST_TEST_EQ(f.size(),input.size());
+    BOOST_TEST(may_contain(f,input));
+
+    std::size_t res=may_contain_count(f,other);
+    double fpr=(double)res/other.size();
+    BOOST_TEST_LT(std::abs(fpr-f.fpr()),0.3*f.fpr()+0.002);
+
+    std::vector<value_type> mixed;
+    for(std::size_t i=0;i<input.size();++i){
+      mixed.push_back(input[i]);
+      mixed.push_back(other[i]);
+    }
+    std::size_t i=0;
+    f.may_contain(mixed.begin(),mixed.end(),[&](const value_type& x,bool r){
+      BOOST_TEST(x==mixed[i]);
+      BOOST_TEST_EQ(r,f.may_contain(mixed[i]));
+      ++i;
+    });
+    BOOST_TEST_EQ(i,mixed.size());
+    i=0;
+    f.count(mixed.begin(),mixed.end(),[&](const value_type&,std::size_t r){
+      BOOST_TEST_EQ(r,f.count(mixed[i]));
+      ++i;
+    });
+    BOOST_TEST_EQ(i,mixed.size());
+
+    /* resizing */
+
+    auto f2=f;
+    f2.resize();
+    BOOST_TEST_EQ(f2.slot_count(),2*slots);
+    BOOST_TEST_EQ(f2.remainder_bits()+1,f.remainder_bits());
+    BOOST_TEST_EQ(f2.size(),f.size());
+    for(const auto& x:mixed)BOOST_TEST_GE(f2.count(x),f.count(x));
+    for(const auto& x:input)BOOST_TEST(f2.erase(x));
+    BOOST_TEST(f2.empty());
+    for(const auto& x:input)BOOST_TEST(!f2.may_contain(x));
+
+    /* counting and bulk erasure */
+
+    f.insert(input.begin(),input.begin()+1000);
+    BOOST_TEST_EQ(f.size(),input.size()+1000);
+    for(std::size_t j=0;j<1000;++j)BOOST_TEST_GE(f.count(input[j]),2u);
+    f.erase(input.begin(),input.end());
+    BOOST_TEST_EQ(f.size(),1000);
+    BOOST_TEST(may_contain(f,std::vector<value_type>(
+      input.begin(),input.begin()+1000)));
+    f.erase(input.begin(),input.begin()+1000);
+    BOOST_TEST(f.empty());
+    BOOST_TEST_EQ(may_contain_count(f,input),0);
+  }
+  {
+    /* automatic growth keeps at least Bits remainder bits */
+
+    filter f(input.size()/16);
+    auto   fbits=f.fingerprint_bits();
+    BOOST_TEST(f.insert(input.begin(),input.end()));
+    BOOST_TEST_EQ(f.size(),input.size());
+    BOOST_TEST_GT(f.slot_count(),input.size());
+    BOOST_TEST_EQ(f.fingerprint_bits(),fbits);
+    BOOST_TEST_GE(f.remainder_bits(),(std::size_t)filter::bits);
+    BOOST_TEST(may_contain(f,input));
+
+    double fpr=(double)may_contain_count(f,other)/other.size();
+    BOOST_TEST_LE(fpr,std::ldexp(1.5,-(int)filter::bits));
+    BOOST_TEST_LE(f.fpr(),std::ldexp(1.0,-(int)filter::bits));
+  }
+  {
+    /* merging, including filters of different sizes */
+
+    std::size_t n=input.size()/2;
+    filter      f1(input.begin(),input.begin()+n,n),
+                f2(input.begin()+n,input.end(),n),
+                f3(input.begin(),input.begin()+100,1000),
+                f4(f1);
+    f1.merge(f2);
+    BOOST_TEST_EQ(f1.size(),input.size());
+    BOOST_TEST_EQ(f1.fingerprint_bits(),f2.fingerprint_bits());
+    BOOST_TEST(may_contain(f1,input));
+
+    filter f5(input.begin(),input.end(),n);
+    BOOST_TEST_EQ(f5.slot_count(),f1.slot_count());
+    BOOST_TEST(f1==f5);
+
+    f3.merge(f4);
+    BOOST_TEST_EQ(f3.size(),n+100);
+    BOOST_TEST_EQ(f3.fingerprint_bits(),f4.fingerprint_bits());
+    BOOST_TEST_GE(f3.slot_count(),f4.slot_count());
+    BOOST_TEST(may_contain(f3,std::vector<value_type>(
+      input.begin(),input.begin()+n)));
+    for(std::size_t i=0;i<100;++i)BOOST_TEST_GE(f3.count(input[i]),2u);
+
+    f4.merge(f4);
+    BOOST_TEST_EQ(f4.size(),2*n);
+    for(std::size_t i=0;i<n;++i)BOOST_TEST_GE(f4.count(input[i]),2u);
+  }
+  {
+    filter f1(input.begin(),input.end(),input.size()),
+           f2(f1),
+           f3(std::move(f2));
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(f2.capacity(),0);
+    BOOST_TEST(f2.empty());
+    f2.insert(input[0]);
+    BOOST_TEST(f2.may_contain(input[0]));
+    f2=f1;
+    BOOST_TEST(f2==f1);
+    f3=filter(input.begin(),input.begin()+100);
+    BOOST_TEST(f3!=f1);
+    swap(f2,f3);
+    BOOST_TEST(f3==f1);
+    for(std::size_t i=0;i<100;++i)BOOST_TEST(f2.may_contain(input[i]));
+    f2=std::move(f3);
+    BOOST_TEST(f2==f1);
+    f2.clear();
+    BOOST_TEST(f2.empty());
+    BOOST_TEST_EQ(may_contain_count(f2,input),0);
+  }
+}
+
+void test_growth()
+{
+  std::vector<int> input,other;
+  for(int i=0;i<200000;++i){
+    input.push_back(i);
+    other.push_back(i+200000);
+  }
+
+  {
+    /* growing well past the initial capacity */
+
+    boost::bloom::quotient_filter<int> f1,f2(1000);
+    for(auto x:input){
+      BOOST_TEST(f1.insert(x));
+      BOOST_TEST(f2.insert(x));
+    }
+    for(const auto* pf:{&f1,&f2}){
+      BOOST_TEST_EQ(pf->size(),input.size());
+      BOOST_TEST_GE(pf->remainder_bits(),8u);
+      BOOST_TEST(may_contain(*pf,input));
+      double fpr=(double)may_contain_count(*pf,other)/other.size();
+      BOOST_TEST_LE(fpr,std::ldexp(1.0,-8));
+      BOOST_TEST_LE(pf->fpr(),std::ldexp(1.0,-8));
+    }
+  }
+  {
+    /* insertion fails rather than dropping below Bits remainder bits */
+
+    using filter=boost::bloom::quotient_filter<int,8,10>;
+
+    filter      f;
+    std::size_t n=0;
+    for(int i=0;i<5000;++i){
+      if(f.insert(input[i]))++n;
+    }
+    BOOST_TEST_LT(n,5000u);
+    BOOST_TEST_GT(n,1000u);
+    BOOST_TEST_EQ(f.size(),n);
+    BOOST_TEST_EQ(f.slot_count(),1024u);
+    BOOST_TEST_EQ(f.remainder_bits(),8u);
+    BOOST_TEST(!f.insert(input.begin()+5000,input.begin()+10000));
+    BOOST_TEST_EQ(f.size(),n);
+    double fpr=(double)may_contain_count(f,other)/other.size();
+    BOOST_TEST_LE(fpr,std::ldexp(1.5,-8));
+    BOOST_TEST_LE(f.fpr(),std::ldexp(1.5,-8));
+    BOOST_TEST_THROWS(
+      (filter(input.begin(),input.begin()+5000)),std::length_error);
+
+    /* merging filters with different fingerprint bits */
+
+    filter f1(input.begin(),input.begin()+100,100),
+           f2(input.begin(),input.begin()+4000,5000);
+    BOOST_TEST_LT(f1.fingerprint_bits(),f2.fingerprint_bits());
+    auto fbits=f1.fingerprint_bits();
+    f1.merge(f2);
+    BOOST_TEST_EQ(f1.size(),4100u);
+    BOOST_TEST_EQ(f1.fingerprint_bits(),fbits);
+    BOOST_TEST_EQ(f1.slot_count(),f2.slot_count());
+    BOOST_TEST(may_contain(f1,std::vector<int>(
+      input.begin(),input.begin()+4000)));
+    for(std::size_t i=0;i<100;++i)BOOST_TEST_GE(f1.count(input[i]),2u);
+  }
+  {
+    boost::bloom::quotient_filter<int,4,8> f;
+    while(f.remainder_bits()>1)f.resize();
+    BOOST_TEST_EQ(f.slot_count(),2048u);
+    BOOST_TEST_THROWS(f.resize(),std::length_error);
+  }
+}
+
+template<typename Filter>
+void test_multiplicity(std::size_t n)
+{
+  using filter=Filter;
+
+  filter f(1000),g(1000);
+  f.insert(1000);
+  g.insert(1000);
+  for(int i=0;i<1000;++i){
+    f.insert(i);
+    g.insert(i);
+  }
+  auto slots=f.slot_count();
+  auto cap=f.capacity();
+
+  /* a key with high multiplicity takes O(log n) slots */
+
+  for(std::size_t i=0;i<n;++i)BOOST_TEST(f.insert(42));
+  BOOST_TEST_EQ(f.size(),n+1001);
+  BOOST_TEST_EQ(f.count(42),n+1);
+  BOOST_TEST_EQ(f.slot_count(),slots);
+  BOOST_TEST_EQ(f.capacity(),cap);
+  for(int i=0;i<=1000;++i)BOOST_TEST_GE(f.count(i),1u);
+
+  auto f2=f;
+  f2.resize();
+  BOOST_TEST_EQ(f2.count(42),n+1);
+  f2.merge(f);
+  BOOST_TEST_EQ(f2.count(42),2*n+2);
+
+  for(std::size_t i=0;i<n;++i)BOOST_TEST(f.erase(42));
+  BOOST_TEST_EQ(f.count(42),1u);
+  BOOST_TEST(f==g);
+  BOOST_TEST(f.erase(1000));
+  BOOST_TEST_EQ(f.count(1000),0u);
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::quotient_filter<int>,
+  boost::bloom::quotient_filter<std::string,7>,
+  boost::bloom::quotient_filter<std::size_t,12>,
+  boost::bloom::quotient_filter<std::uint64_t,20>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_quotient_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  test_model<10>();
+  test_model<16>();
+  test_model<24>();
+  test_model<1,13>();
+  test_model<3,14>();
+  test_growth();
+  test_multiplicity<boost::bloom::quotient_filter<int>>(200000);
+  test_multiplicity<boost::bloom::quotient_filter<int,16>>(200000);
+  test_multiplicity<boost::bloom::quotient_filter<int,1,12>>(5000);
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,190 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/range_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+template<typename Filter>
+void test_range_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+  using range=std::pair<value_type,value_type>;
+  using limits=std::numeric_limits<value_type>;
+
+  static constexpr std::uint64_t w=64;
+
+  /* keys spread over a subdomain of up to 2^20 values so that ranges of
+   * width up to w are empty with noticeable probability
+   */
+
+  std::mt19937_64     rng;
+  const value_type    lo=limits::is_signed?
+                        (value_type)(limits::min()/2):limits::min();
+  const std::uint64_t span=std::min<std::uint64_t>(
+                        (std::uint64_t)limits::max()/2,1u<<20);
+  auto                key=[&]{
+    return (value_type)(lo+(value_type)(rng()%span));
+  };
+  std::vector<value_type> input;
+  std::set<value_type>    keys;
+  for(int i=0;i<1000;++i){
+    input.push_back(key());
+    keys.insert(input.back());
+  }
+  auto any_in=[&](value_type a,value_type b){
+    auto it=keys.lower_bound(a);
+    return it!=keys.end()&&*it<=b;
+  };
+  std::vector<range> ranges;
+  for(int i=0;i<10000;++i){
+    value_type    a=key();
+    std::uint64_t width=rng()%w;
+    value_type    b=(value_type)(a+(value_type)width);
+    if(b<a)b=limits::max();
+    ranges.push_back({a,b});
+  }
+
+  BOOST_TEST_EQ(filter{}.max_range_width(),1);
+  BOOST_TEST_EQ(filter(0,w).max_range_width(),w);
+  BOOST_TEST_EQ(filter(0,w+1).max_range_width(),2*w);
+  BOOST_TEST_EQ(
+    filter(0,~std::uint64_t(0)).max_range_width(),
+    std::uint64_t(1)<<std::min(limits::digits+limits::is_signed,63));
+  BOOST_TEST_GT(
+    filter::capacity_for(1000,0.01,w),filter::capacity_for(1000,0.01,1));
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0);
+    f.insert(input.begin(),input.end());
+    f.insert(input[0]);
+    BOOST_TEST(f.may_contain(input[0]));
+    BOOST_TEST(f.may_contain_range(input[0],input[0]));
+  }
+  {
+    filter f(input.size(),0.01,w);
+    BOOST_TEST_GE(f.capacity(),filter::capacity_for(input.size(),0.01,w));
+    BOOST_TEST_EQ(f.max_range_width(),w);
+    for(const auto& x:input){
+      f.insert(x);
+      BOOST_TEST(f.may_contain(x));
+      BOOST_TEST(f.may_contain_range(x,x));
+    }
+
+    /* no false negatives, and a low FPR for empty ranges */
+
+    std::size_t empty=0,fp=0;
+    for(const auto& r:ranges){
+      bool res=f.may_contain_range(r.first,r.second);
+      if(any_in(r.first,r.second))BOOST_TEST(res);
+      else{
+        ++empty;
+        fp+=res;
+      }
+    }
+    BOOST_TEST_GT(empty,ranges.size()/10);
+    BOOST_TEST_LE((double)fp/empty,0.05);
+
+    /* ranges around each key, and special ranges */
+
+    for(const auto& x:input){
+      value_type a=x>lo+10?(value_type)(x-10):lo,
+                 b=x<limits::max()-10?(value_type)(x+10):limits::max();
+      BOOST_TEST(f.may_contain_range(a,b));
+      BOOST_TEST(f.may_contain_range(x,b));
+      BOOST_TEST(f.may_contain_range(a,x));
+    }
+    BOOST_TEST(!f.may_contain_range(limits::max(),limits::min()));
+    BOOST_TEST(f.may_contain_range(limits::min(),limits::max()));
+
+    std::size_t i=0;
+    f.may_contain_range(
+      ranges.begin(),ranges.end(),
+      [&](const range& r,bool res){
+        BOOST_TEST(r==ranges[i++]);
+        BOOST_TEST_EQ(res,f.may_contain_range(r.first,r.second));
+      });
+    BOOST_TEST_EQ(i,ranges.size());
+
+    i=0;
+    f.may_contain(
+      input.begin(),input.end(),
+      [&](const value_type& x,bool res){
+        BOOST_TEST(x==input[i++]);
+        BOOST_TEST(res);
+      });
+    BOOST_TEST_EQ(i,input.size());
+  }
+  {
+    /* bulk and one-by-one insertion are equivalent */
+
+    for(std::size_t n:{
+      (std::size_t)0,(std::size_t)1,
+      (std::size_t)filter::bulk_insert_size+1,input.size()}){
+      filter f1(input.begin(),input.begin()+n,10000,w),
+             f2(10000,w);
+      for(std::size_t i=0;i<n;++i)f2.insert(input[i]);
+      BOOST_TEST(f1==f2);
+    }
+    BOOST_TEST(filter(10000,w)!=filter(10000,2*w));
+  }
+  {
+    filter f1(input.begin(),input.end(),10000,w),
+           f2(f1),
+           f3(std::move(f2));
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(f2.capacity(),0);
+    f2=f1;
+    BOOST_TEST(f2==f1);
+    f3=filter({input[0]},10000,2*w);
+    BOOST_TEST(f3!=f1);
+    swap(f2,f3);
+    BOOST_TEST(f3==f1);
+    BOOST_TEST_EQ(f2.max_range_width(),2*w);
+    f2=std::move(f3);
+    BOOST_TEST(f2==f1);
+    f2.clear();
+    BOOST_TEST(f2==filter(10000,w));
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::range_filter<std::uint64_t,5>,
+  boost::bloom::range_filter<int,1,boost::bloom::block<std::uint64_t,6>>,
+  boost::bloom::range_filter<
+    std::int64_t,1,boost::bloom::multiblock<std::uint32_t,5>>,
+  boost::bloom::range_filter<unsigned short,3>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_range_filter<typename T::type>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,134 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/ribbon_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_ribbon_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          other;
+  for(int i=0;i<20000;++i)input.push_back(fac());
+  for(int i=0;i<50000;++i)other.push_back(fac());
+
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0);
+    BOOST_TEST_EQ(f.shard_count(),0);
+    for(const auto& x:input)BOOST_TEST(!f.may_contain(x));
+    f.may_contain(input.begin(),input.end(),[](const value_type&,bool res){
+      BOOST_TEST(!res);
+    });
+
+    filter f2(input.begin(),input.begin());
+    BOOST_TEST(f2==f);
+  }
+  for(std::size_t n:{1,10,1000,20000}){
+    filter f1(input.begin(),input.begin()+n),
+           f2(input.begin(),input.begin()+n,4);
+    BOOST_TEST_EQ(f1.shard_count(),(n+filter::shard_size-1)/filter::shard_size);
+    BOOST_TEST(f1==f2);
+    for(std::size_t i=0;i<n;++i)BOOST_TEST(f1.may_contain(input[i]));
+
+    /* space overhead with respect to n*Bits, excluding the padding block
+     * and shard metadata
+     */
+
+    if(n>=filter::shard_size){
+      BOOST_TEST_LT(
+        (double)(f1.capacity()-64*(filter::bits+2*f1.shard_count())),
+        (double)(n*filter::bits)*1.07);
+    }
+
+    std::size_t res=0;
+    for(const auto& x:other)res+=f1.may_contain(x);
+    double fpr=(double)res/other.size();
+    BOOST_TEST_LT(std::abs(fpr-filter::fpr()),0.2*filter::fpr()+0.002);
+
+    std::vector<value_type> mixed;
+    for(std::size_t i=0;i<n;++i){
+      mixed.push_back(input[i]);
+      mixed.push_back(other[i]);
+    }
+    std::size_t i=0;
+    f1.may_contain(mixed.begin(),mixed.end(),[&](const value_type& x,bool r){
+      BOOST_TEST(x==mixed[i]);
+      BOOST_TEST_EQ(r,f1.may_contain(mixed[i]));
+      ++i;
+    });
+    BOOST_TEST_EQ(i,mixed.size());
+  }
+  {
+    /* duplicates */
+
+    std::vector<value_type> dup(input.begin(),input.begin()+5000);
+    dup.insert(dup.end(),input.begin(),input.begin()+5000);
+    filter f(dup.begin(),dup.end());
+    for(const auto& x:dup)BOOST_TEST(f.may_contain(x));
+  }
+  {
+    filter f1(input.begin(),input.end()),
+           f2(f1),
+           f3(std::move(f2));
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(f2.capacity(),0);
+    f2=f1;
+    BOOST_TEST(f2==f1);
+    f3=filter(input.begin(),input.begin()+100);
+    BOOST_TEST(f3!=f1);
+    swap(f2,f3);
+    BOOST_TEST(f3==f1);
+    for(std::size_t i=0;i<100;++i)BOOST_TEST(f2.may_contain(input[i]));
+    f2=std::move(f3);
+    BOOST_TEST(f2==f1);
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::ribbon_filter<int>,
+  boost::bloom::ribbon_filter<std::string,7>,
+  boost::bloom::ribbon_filter<std::size_t,1>,
+  boost::bloom::ribbon_filter<std::uint64_t,13>,
+  boost::bloom::ribbon_filter<int,32>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_ribbon_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,135 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/sectorized_block.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* Subfilter using the generic implementation of sectorized_block even
+ * when a SIMD specialization exists.
+ */
+
+template<typename Block,std::size_t Sectors,std::size_t K>
+struct generic_sectorized_block:
+  boost::bloom::detail::sectorized_block_fpr_base<Sectors,K>,
+  boost::bloom::detail::sectorized_block_impl<
+    Block,Sectors,K,std::false_type>
+{
+  static constexpr std::size_t k=K;
+  static constexpr std::size_t sectors=Sectors;
+  using value_type=Block[Sectors];
+};
+
+template<typename Filter>
+void test_sectorized_block()
+{
+  using value_type=typename Filter::value_type;
+  using subfilter=typename Filter::subfilter;
+  using generic_filter=boost::bloom::filter<
+    value_type,Filter::k,
+    generic_sectorized_block<
+      typename std::remove_extent<typename subfilter::value_type>::type,
+      subfilter::sectors,subfilter::k>,
+    Filter::stride
+  >;
+
+  std::vector<value_type>   input;
+  value_factory<value_type> fac;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  Filter         f(10000);
+  generic_filter gf(10000);
+  f.insert(input.begin(),input.end());
+  gf.insert(input.begin(),input.end());
+  BOOST_TEST(std::equal(
+    f.array().begin(),f.array().end(),gf.array().begin()));
+
+  for(const auto& x:input){
+    BOOST_TEST(f.may_contain(x));
+    BOOST_TEST(gf.may_contain(x));
+  }
+  for(int i=0;i<1000;++i){
+    auto x=fac();
+    BOOST_TEST_EQ(f.may_contain(x),gf.may_contain(x));
+  }
+}
+
+template<typename Block,std::size_t K>
+void test_fpr()
+{
+  /* sectorized_block<Block,1,K> and sectorized_block<Block,K,K> are
+   * statistically equivalent to block<Block,K> and multiblock<Block,K>,
+   * respectively, and FPR worsens as the number of sectors grows.
+   */
+
+  using sb1=boost::bloom::sectorized_block<Block,1,K>;
+  using sb2=boost::bloom::sectorized_block<Block,2,K>;
+  using sbk=boost::bloom::sectorized_block<Block,K,K>;
+  using bk=boost::bloom::block<Block,K>;
+  using mbk=boost::bloom::multiblock<Block,K>;
+
+  for(std::size_t i=1;i<=64;i*=2){
+    std::size_t w=sizeof(Block)*K*CHAR_BIT;
+    BOOST_TEST_LT(std::abs(sb1::fpr(i,w)-bk::fpr(i,w)),1.0E-9);
+    BOOST_TEST_LT(std::abs(sbk::fpr(i,w)-mbk::fpr(i,w)),1.0E-9);
+    BOOST_TEST_LE(sb1::fpr(i,w),sb2::fpr(i,w));
+    BOOST_TEST_LE(sb2::fpr(i,w),sbk::fpr(i,w));
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::filter<
+    int,1,boost::bloom::sectorized_block<std::uint64_t,4,4>
+  >,
+  boost::bloom::filter<
+    int,1,boost::bloom::sectorized_block<std::uint64_t,4,7>,5
+  >,
+  boost::bloom::filter<
+    std::size_t,2,boost::bloom::sectorized_block<std::uint64_t,8,8>
+  >,
+  boost::bloom::filter<
+    int,1,boost::bloom::sectorized_block<std::uint64_t,8,13>
+  >,
+  boost::bloom::filter<
+    int,1,boost::bloom::sectorized_block<std::uint32_t,4,9>
+  >
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_sectorized_block<typename T::type>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  test_fpr<std::uint64_t,4>();
+  test_fpr<std::uint32_t,8>();
+  return boost::report_errors();
+}
@@ -0,0 +1,125 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/sharded_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter>
+struct sharded_filter_for_impl;
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+struct sharded_filter_for_impl<boost::bloom::filter<T,K,SF,S,H,A>>
+{
+  using type=boost::bloom::sharded_filter<T,K,SF,S,H,A>;
+};
+
+template<typename Filter>
+using sharded_filter_for=typename sharded_filter_for_impl<Filter>::type;
+
+template<typename Filter,typename ValueFactory>
+void test_sharded_filter()
+{
+  using filter=Filter;
+  using sharded_filter=sharded_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+
+  BOOST_TEST_THROWS((sharded_filter{1000,0}),std::invalid_argument);
+  {
+    sharded_filter f(0,5);
+    BOOST_TEST_EQ(f.shard_count(),5);
+    BOOST_TEST_EQ(f.capacity(),0);
+    f.insert(input[0]);
+    f.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(f.capacity(),0);
+  }
+  {
+    sharded_filter f1(20000,7),f2(20000,7);
+    BOOST_TEST_GE(f1.capacity(),20000);
+    for(const auto& x:input)f1.insert(x);
+    f2.insert(make_input_iterator(input.begin()),make_input_iterator(input.end()));
+    for(const auto& x:input){
+      BOOST_TEST(f1.may_contain(x));
+      BOOST_TEST(f2.may_contain(x));
+    }
+    std::size_t res1=0,res2=0;
+    for(int i=0;i<2000;++i){
+      auto x=fac();
+      res1+=f1.may_contain(x);
+      res2+=f2.may_contain(x);
+    }
+    BOOST_TEST_EQ(res1,res2);
+
+    f1.clear();
+    for(const auto& x:input)BOOST_TEST(!f1.may_contain(x));
+    f1|=f2;
+    for(const auto& x:input)BOOST_TEST(f1.may_contain(x));
+    f1.reset(5000);
+    BOOST_TEST_LT(f1.capacity(),20000);
+    BOOST_TEST_THROWS(f1|=f2,std::invalid_argument);
+    BOOST_TEST_THROWS(f2&=f1,std::invalid_argument);
+    f2.reset(5000);
+    f2.insert(input.begin(),input.end());
+    f2&=f1;
+    for(const auto& x:input)BOOST_TEST(!f2.may_contain(x));
+
+    sharded_filter f3(20000,3);
+    BOOST_TEST_THROWS(f3|=f2,std::invalid_argument);
+    BOOST_TEST_THROWS(f3&=f2,std::invalid_argument);
+  }
+  {
+    sharded_filter           f(100000,16);
+    std::vector<std::thread> threads;
+    const std::size_t        num_threads=4,
+                             chunk=input.size()/num_threads;
+    for(std::size_t t=0;t<num_threads;++t){
+      threads.emplace_back([&,t]{
+        auto first=input.begin()+t*chunk,last=first+chunk;
+        if(t%2)f.insert(first,last);
+        else   for(;first!=last;++first)f.insert(*first);
+        for(auto it=input.begin();it!=input.end();++it)(void)f.may_contain(*it);
+        if(t==0)f|=f;
+      });
+    }
+    for(auto& th:threads)th.join();
+    for(std::size_t i=0;i<num_threads*chunk;++i){
+      BOOST_TEST(f.may_contain(input[i]));
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_sharded_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,146 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/stable_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_stable_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,
+                          fresh;
+  for(int i=0;i<200000;++i)input.push_back(fac());
+  for(int i=0;i<10000;++i)fresh.push_back(fac());
+
+  for(double fpr:{0.2,0.05,0.01,0.001}){
+    std::size_t p=filter::decrements_for(fpr);
+    BOOST_TEST_GT(p,0);
+    BOOST_TEST_LE(filter::fpr_for(p),fpr);
+    BOOST_TEST(p==1||filter::fpr_for(p-1)>fpr);
+  }
+  BOOST_TEST_EQ(filter::decrements_for(1.0),0);
+  BOOST_TEST_EQ(filter::fpr_for(0),1.0);
+
+  std::size_t p=filter::decrements_for(0.01);
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0);
+    BOOST_TEST_EQ(f.cell_count(),0);
+    BOOST_TEST_EQ(f.decrements(),0);
+    f.insert(input.begin(),input.end());
+    f.insert(input[0]);
+    BOOST_TEST(f.may_contain(input[0]));
+    f.may_contain(
+      input.begin(),input.end(),
+      [](const value_type&,bool res){BOOST_TEST(res);});
+  }
+  {
+    filter f(100000,p);
+    BOOST_TEST_GE(f.capacity(),100000);
+    BOOST_TEST_EQ(f.cell_count(),f.capacity()/filter::cell_width);
+    BOOST_TEST_EQ(f.decrements(),p);
+    BOOST_TEST_EQ(f.fpr(),filter::fpr_for(p));
+
+    /* the element just inserted is always present */
+
+    for(const auto& x:input){
+      f.insert(x);
+      BOOST_TEST(f.may_contain(x));
+    }
+
+    /* stationary FPR, which old elements also converge to */
+
+    std::size_t fp=0,old=0;
+    for(const auto& x:fresh)fp+=f.may_contain(x);
+    for(std::size_t i=0;i<fresh.size();++i)old+=f.may_contain(input[i]);
+    BOOST_TEST_LE((double)fp/fresh.size(),1.5*f.fpr()+0.002);
+    BOOST_TEST_GE((double)fp/fresh.size(),0.5*f.fpr()-0.002);
+    BOOST_TEST_LE((double)old/fresh.size(),1.5*f.fpr()+0.002);
+
+    std::size_t i=0;
+    f.may_contain(
+      input.begin(),input.end(),
+      [&](const value_type& x,bool res){
+        BOOST_TEST(x==input[i++]);
+        BOOST_TEST_EQ(res,f.may_contain(x));
+      });
+    BOOST_TEST_EQ(i,input.size());
+  }
+  {
+    /* bulk and one-by-one insertion are equivalent */
+
+    for(std::size_t n:{
+      (std::size_t)0,(std::size_t)1,
+      (std::size_t)filter::bulk_insert_size+1,input.size()}){
+      filter f1(input.begin(),input.begin()+n,100000,p),
+             f2(100000,p);
+      for(std::size_t i=0;i<n;++i)f2.insert(input[i]);
+      BOOST_TEST(f1==f2);
+    }
+  }
+  {
+    filter f1(input.begin(),input.end(),100000,p),
+           f2(f1),
+           f3(std::move(f2));
+    BOOST_TEST(f1==f3);
+    BOOST_TEST_EQ(f2.capacity(),0);
+    f2=f1;
+    BOOST_TEST(f2==f1);
+    f3=filter(fresh.begin(),fresh.end(),100000,p);
+    BOOST_TEST(f3!=f1);
+    swap(f2,f3);
+    BOOST_TEST(f3==f1);
+    f2=std::move(f3);
+    BOOST_TEST(f2==f1);
+    f2.clear();
+    BOOST_TEST(f2==filter(100000,p));
+    BOOST_TEST_EQ(f2.decrements(),p);
+  }
+}
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::stable_filter<int,3>,
+  boost::bloom::stable_filter<std::string,4,4>,
+  boost::bloom::stable_filter<std::size_t,2,1>,
+  boost::bloom::stable_filter<std::uint64_t,7,2>
+>;
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_stable_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>
+  >(lambda{});
+  return boost::report_errors();
+}
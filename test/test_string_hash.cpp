@@ -0,0 +1,136 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/string_hash.hpp>
+#include <boost/container_hash/hash_is_avalanching.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+#include <string_view>
+#endif
+
+void test_reference_values()
+{
+  /* test vectors from https://github.com/wangyi-fudan/wyhash, valid for
+   * little-endian platforms only.
+   */
+
+  const std::uint16_t one=1;
+  if(*reinterpret_cast<const unsigned char*>(&one)!=1)return;
+
+  static const char* msgs[]={
+    "",
+    "a",
+    "abc",
+    "message digest",
+    "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    "123456789012345678901234567890123456789012345678901234567890"
+    "12345678901234567890"
+  };
+  static const std::uint64_t hashes[]={
+    0x93228a4de0eec5a2ull,0xc5bac3db178713c4ull,0xa97f2f7b1d9b3314ull,
+    0x786d1f1df3801df4ull,0xdca5a8138ad37c87ull,0xb9e734f117cfaf70ull,
+    0x6cc5eab49a92d617ull
+  };
+
+  for(std::size_t i=0;i<sizeof(msgs)/sizeof(msgs[0]);++i){
+    BOOST_TEST_EQ(
+      boost::bloom::detail::wyhash(msgs[i],std::strlen(msgs[i]),i),
+      hashes[i]);
+  }
+}
+
+void test_string_hash()
+{
+  using hasher=boost::bloom::string_hash;
+
+  BOOST_TEST(boost::hash_is_avalanching<hasher>::value);
+
+  hasher h,h1(1);
+  for(std::size_t n=0;n<200;++n){
+    std::string str(n,'x');
+    for(std::size_t i=0;i<n;++i)str[i]=(char)('a'+i*7%26);
+    BOOST_TEST_EQ(h(str),h(str.c_str()));
+    BOOST_TEST_EQ(h(str),h.hash(str.data(),str.size()));
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+    BOOST_TEST_EQ(h(str),h(std::string_view(str)));
+#endif
+    BOOST_TEST_NE(h(str),h1(str));
+
+    /* every byte contributes to the hash value */
+
+    for(std::size_t i=0;i<n;++i){
+      std::string str2=str;
+      str2[i]^=1;
+      BOOST_TEST_NE(h(str),h(str2));
+    }
+  }
+
+  /* flipping one input bit flips about half the output bits */
+
+  std::size_t flipped=0,total=0;
+  for(std::uint64_t i=0;i<1000;++i){
+    char        buf[8];
+    std::memcpy(buf,&i,sizeof(buf));
+    std::size_t x=h.hash(buf,sizeof(buf));
+    for(std::size_t j=0;j<sizeof(buf)*8;++j){
+      char buf2[8];
+      std::memcpy(buf2,buf,sizeof(buf));
+      buf2[j/8]^=(char)(1<<(j%8));
+      std::uint64_t y=x^h.hash(buf2,sizeof(buf2));
+      for(;y;y&=y-1)++flipped;
+      total+=sizeof(std::size_t)*8;
+    }
+  }
+  BOOST_TEST_GT((double)flipped/total,0.49);
+  BOOST_TEST_LT((double)flipped/total,0.51);
+}
+
+void test_filter()
+{
+  using filter=boost::bloom::filter<std::string,5,
+    boost::bloom::block<unsigned char,1>,0,boost::bloom::string_hash>;
+
+  std::vector<std::string> input;
+  for(int i=0;i<1000;++i)input.push_back("element #"+std::to_string(i));
+
+  filter f(10000);
+  f.insert(input.begin(),input.end());
+  f.insert("c string");
+  for(const auto& x:input){
+    BOOST_TEST(f.may_contain(x));
+    BOOST_TEST(f.may_contain(x.c_str()));
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+    BOOST_TEST(f.may_contain(std::string_view(x)));
+#endif
+  }
+  BOOST_TEST(f.may_contain(std::string("c string")));
+
+  std::vector<const char*> c_input;
+  for(const auto& x:input)c_input.push_back(x.c_str());
+  std::size_t n=0;
+  f.may_contain(c_input.begin(),c_input.end(),[&](const char*,bool res){
+    BOOST_TEST(res);
+    ++n;
+  });
+  BOOST_TEST_EQ(n,c_input.size());
+}
+
+int main()
+{
+  test_reference_values();
+  test_string_hash();
+  test_filter();
+  return boost::report_errors();
+}
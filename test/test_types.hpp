@@ -14,6 +14,7 @@
 #include <boost/bloom/fast_multiblock64.hpp>
 #include <boost/bloom/filter.hpp>
 #include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/sectorized_block.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 #include <boost/mp11/utility.hpp>
@@ -30,6 +31,12 @@ using test_types=boost::mp11::mp_list<
   boost::bloom::filter<
    int,1,boost::bloom::block<std::uint32_t[4],4>
   >,
+  boost::bloom::filter<
+   int,1,boost::bloom::block<std::uint64_t,6>
+  >,
+  boost::bloom::filter<
+   std::size_t,1,boost::bloom::block<std::uint64_t,8>,1
+  >,
   boost::bloom::filter<
     std::size_t,1,boost::bloom::multiblock<std::uint64_t,3>
   >,
@@ -41,6 +48,12 @@ using test_types=boost::mp11::mp_list<
   >,
   boost::bloom::filter<
     int,1,boost::bloom::fast_multiblock64<11>
+  >,
+  boost::bloom::filter<
+    std::size_t,1,boost::bloom::sectorized_block<std::uint64_t,8,10>
+  >,
+  boost::bloom::filter<
+    std::string,1,boost::bloom::sectorized_block<std::uint16_t[2],2,5>,3
   >
 >;
 